@@ -1,6 +1,12 @@
 #include <iostream>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <set>
+#include <array>
+#include <bitset>
+#include <memory>
+#include <deque>
 #include <string>
 #include <iomanip>
 #include <algorithm>
@@ -10,9 +16,193 @@
 #include <cmath>
 #include <limits>
 #include <functional>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <string_view>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cerrno>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
+// Text of a formatted timestamp. It is returned by value, so several timestamps can
+// be used in one expression
+struct TimestampText {
+    char text[32];
+    int length;
+
+    operator string_view() const {
+        return string_view(text, length);
+    }
+};
+
+ostream& operator<<(ostream& out, const TimestampText& timestamp) {
+    return out << string_view(timestamp);
+}
+
+// Format a timestamp like ctime() (without the trailing newline). Thread-safe: each
+// thread caches the text of the last minute it formatted and only patches the seconds
+TimestampText formatTimestamp(time_t t) {
+    static const char* const DAYS[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static const char* const MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                         "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    thread_local time_t cachedMinute = numeric_limits<time_t>::min();
+    thread_local TimestampText cached;
+
+    time_t second = ((t % 60) + 60) % 60;
+    time_t minute = t - second;
+    if (minute != cachedMinute) {
+        struct tm local;
+#ifdef _WIN32
+        localtime_s(&local, &t);
+#else
+        localtime_r(&t, &local);
+#endif
+        cached.length = snprintf(cached.text, sizeof(cached.text), "%.3s %.3s%3d %.2d:%.2d:%.2d %d",
+                                 DAYS[local.tm_wday], MONTHS[local.tm_mon], local.tm_mday, local.tm_hour,
+                                 local.tm_min, 0, 1900 + local.tm_year);
+        cachedMinute = minute;
+    }
+    TimestampText result = cached;
+    result.text[17] = static_cast<char>('0' + second / 10);
+    result.text[18] = static_cast<char>('0' + second % 10);
+    return result;
+}
+
+// Console table renderer shared by the reports
+//
+// Cells are appended into one growing buffer and the width of every column is
+// updated as cells arrive. render() formats the requested rows into a single
+// string and writes it with one call, so large reports are not slowed down by
+// per-row flushes.
+class ReportTable {
+
+public:
+
+    enum Align { LEFT, RIGHT };
+
+private:
+
+    vector<string> headers;
+    vector<Align> alignment;
+    vector<size_t> widths;    // Cached widest cell per column
+    string cells;             // Text of every cell, back to back
+    vector<size_t> cellEnds;  // End offset of each cell in 'cells'
+
+public:
+
+    explicit ReportTable(vector<string> columnHeaders, vector<Align> columnAlignment = {})
+        : headers(std::move(columnHeaders)), alignment(std::move(columnAlignment)) {
+        alignment.resize(headers.size(), LEFT);
+        for (const string& header : headers) {
+            widths.push_back(header.size());
+        }
+    }
+
+    // Append the next cell; rows wrap automatically after the last column
+    ReportTable& cell(string_view text) {
+        size_t column = cellEnds.size() % headers.size();
+        cells.append(text.data(), text.size());
+        cellEnds.push_back(cells.size());
+        widths[column] = max(widths[column], text.size());
+        return *this;
+    }
+
+    ReportTable& cell(const string& text) {
+        return cell(string_view(text));
+    }
+
+    ReportTable& cell(const char* text) {
+        return cell(string_view(text));
+    }
+
+    ReportTable& cell(long long value) {
+        char buffer[24];
+        auto result = to_chars(buffer, buffer + sizeof(buffer), value);
+        return cell(string_view(buffer, result.ptr - buffer));
+    }
+
+    ReportTable& cell(int value) {
+        return cell(static_cast<long long>(value));
+    }
+
+    ReportTable& cell(size_t value) {
+        return cell(static_cast<long long>(value));
+    }
+
+    // Doubles are printed like the default ostream format (6 significant digits)
+    ReportTable& cell(double value) {
+        char buffer[32];
+        int length = snprintf(buffer, sizeof(buffer), "%g", value);
+        return cell(string_view(buffer, length));
+    }
+
+    // Number of complete rows
+    size_t rowCount() const {
+        return cellEnds.size() / headers.size();
+    }
+
+    // Write rows [firstRow, firstRow + maxRows) with the header in one call
+    void render(ostream& out, size_t firstRow = 0, size_t maxRows = numeric_limits<size_t>::max()) const {
+        size_t columns = headers.size();
+        size_t rows = rowCount();
+        size_t lastRow = firstRow + min(maxRows, rows - min(firstRow, rows));
+        size_t lineWidth = 0;
+        for (size_t width : widths) {
+            lineWidth += width + 2;
+        }
+
+        string buffer;
+        buffer.reserve((lineWidth + 1) * (lastRow - min(firstRow, lastRow) + 3));
+        auto appendCell = [&](string_view text, size_t column) {
+            size_t padding = widths[column] - text.size();
+            if (alignment[column] == RIGHT) {
+                buffer.append(padding, ' ');
+            }
+            buffer.append(text.data(), text.size());
+            if (alignment[column] == LEFT && column + 1 < columns) {
+                buffer.append(padding, ' ');
+            }
+            if (column + 1 < columns) {
+                buffer.append(2, ' ');
+            }
+        };
+
+        for (size_t column = 0; column < columns; ++column) {
+            appendCell(headers[column], column);
+        }
+        buffer += '\n';
+        buffer.append(lineWidth - 2, '-');
+        buffer += '\n';
+
+        for (size_t row = firstRow; row < lastRow; ++row) {
+            for (size_t column = 0; column < columns; ++column) {
+                size_t index = row * columns + column;
+                size_t begin = index == 0 ? 0 : cellEnds[index - 1];
+                appendCell(string_view(cells.data() + begin, cellEnds[index] - begin), column);
+            }
+            buffer += '\n';
+        }
+        if (lastRow < rows) {
+            buffer += "(" + to_string(rows - lastRow) + " more rows not shown)\n";
+        }
+
+        out.write(buffer.data(), buffer.size());
+        out.flush();
+    }
+};
+
 // Structure to store the data of each area
 struct Area {
     int id;
@@ -37,52 +227,32 @@ struct Area {
      // Environmental impact score (0-100)
     double budgetAllocated;
      // Budget allocated for waste management
+    double latitude;
+    double longitude;
+     // Coordinates in decimal degrees (NaN when the area has not been located)
 
 
     // Default constructor to initialize all members with default values
 
     Area() : id(0), name(""), wasteQuantity(0.0), wasteCategory("General"), areaSize(0.0),
              location(""), population(0), lastUpdated(time(0)), wasteManagementStrategy("None"),
-             environmentalImpactScore(0.0), budgetAllocated(0.0) {}
+             environmentalImpactScore(0.0), budgetAllocated(0.0),
+             latitude(numeric_limits<double>::quiet_NaN()), longitude(numeric_limits<double>::quiet_NaN()) {}
 
     // Parametrized constructor to initialize all members with specific values
 
     Area(int id, string name, double wasteQuantity, string wasteCategory, double areaSize,
          string location, int population, time_t lastUpdated, string wasteManagementStrategy,
-         double environmentalImpactScore, double budgetAllocated)
+         double environmentalImpactScore, double budgetAllocated,
+         double latitude = numeric_limits<double>::quiet_NaN(), double longitude = numeric_limits<double>::quiet_NaN())
          : id(id), name(name), wasteQuantity(wasteQuantity), wasteCategory(wasteCategory),
            areaSize(areaSize), location(location), population(population), lastUpdated(lastUpdated),
            wasteManagementStrategy(wasteManagementStrategy), environmentalImpactScore(environmentalImpactScore),
-           budgetAllocated(budgetAllocated) {}
-
-    // Method to display area details in tabular format
-
-    void displayAreaInfo() const {
-
-        // Displaying area details in a structured format for readability
-        cout << left << setw(2) << id // Displaying ID with 10 characters width
-
-             << setw(17) << name // Displaying area name with 25 characters width
-
-             << setw(6) << wasteQuantity // Displaying waste quantity with 20 characters width
-             << setw(11) << wasteCategory // Displaying waste category with 15 characters width
-
-             << setw(3) << areaSize // Displaying area size with 15 characters width
-
-             << setw(7) << location // Displaying location with 20 characters width
-
-             << setw(6) << population // Displaying population with 12 characters width
-
-
-             << setw(10) << wasteManagementStrategy // Displaying waste management strategy with 20 characters width
+           budgetAllocated(budgetAllocated), latitude(latitude), longitude(longitude) {}
 
-             << setw(13) << environmentalImpactScore // Displaying environmental impact score with 18 characters width
-
-             << setw(12) << budgetAllocated // Displaying budget allocated with 15 characters width
-
-             << setw(25) << ctime(&lastUpdated) // Print time in readable format using ctime
-
-             << endl;
+    // Method to check whether the area has coordinates
+    bool hasCoordinates() const {
+        return !std::isnan(latitude) && !std::isnan(longitude);
     }
 
     // Method to calculate waste density (Waste quantity per square km)
@@ -101,6 +271,14 @@ struct Area {
     }
 
 
+    // Method to calculate waste generated per resident (tons per person)
+
+    double calculateWastePerCapita() const {
+        // Prevent division by zero for areas without recorded population
+        return population > 0 ? wasteQuantity / population : 0;
+    }
+
+
     // Method to get the age of the area in days since last update
 
     int getDaysSinceLastUpdate() const {
@@ -109,464 +287,7144 @@ struct Area {
     }
 };
 
-// Graph class to represent a weighted graph of areas
-class Graph {
+// Small integer handle for an interned string
+typedef uint32_t Symbol;
 
-public:
+// Shared table of interned strings; each distinct value is stored once and
+// referred to by its Symbol, so equal values compare as equal integers
+class SymbolTable {
 
-    unordered_map<int, Area> nodes; // Hashmap to store areas by their ID
+private:
 
-    // Method to add a new area to the system
-    void addArea(int id, string name, double wasteQuantity, string wasteCategory, double areaSize,
-                 string location, int population, time_t lastUpdated, string wasteManagementStrategy,
-                 double environmentalImpactScore, double budgetAllocated) {
-        // Create a new Area object and add it to the 'nodes' map using the area ID as the key
-        nodes[id] = Area(id, name, wasteQuantity, wasteCategory, areaSize, location, population,
-                         lastUpdated, wasteManagementStrategy, environmentalImpactScore, budgetAllocated);
+    deque<string> names; // Deque keeps the strings at stable addresses
+    unordered_map<string_view, Symbol> symbols; // Views into 'names'
+
+public:
+
+    // Handle for 'value', adding it to the table if it is new
+    Symbol intern(string_view value) {
+        auto it = symbols.find(value);
+        if (it != symbols.end()) {
+            return it->second;
+        }
+        Symbol symbol = static_cast<Symbol>(names.size());
+        names.emplace_back(value);
+        symbols.emplace(string_view(names.back()), symbol);
+        return symbol;
     }
 
+    // Look up 'value' without adding it; returns false if it was never interned
+    bool find(string_view value, Symbol& symbol) const {
+        auto it = symbols.find(value);
+        if (it == symbols.end()) {
+            return false;
+        }
+        symbol = it->second;
+        return true;
+    }
 
-    // Method to display all areas in the system in tabular format
+    // String for a handle
+    const string& name(Symbol symbol) const {
+        return names[symbol];
+    }
 
-    void displayAreas() const {
-        // Displaying column headers for the tabular format
-          cout << "\nAreas in the system (sorted by waste quantity):\n";
-            cout << left << setw(2) << "AID"
+    // Number of distinct strings
+    size_t size() const {
+        return names.size();
+    }
+};
 
-         << setw(17) << "ArName"
+// Columnar store for the area registry: every field lives in its own contiguous array
+// so scans over one numeric field touch only that field's memory. Category, location
+// and strategy are stored as Symbols and resolved through the shared symbol table
+struct AreaColumns {
+    shared_ptr<SymbolTable> symbols = make_shared<SymbolTable>();
+
+    vector<int> id;
+    vector<string> name;
+    vector<double> wasteQuantity;
+    vector<Symbol> wasteCategory;
+    vector<double> areaSize;
+    vector<Symbol> location;
+    vector<int> population;
+    vector<time_t> lastUpdated;
+    vector<Symbol> wasteManagementStrategy;
+    vector<double> environmentalImpactScore;
+    vector<double> budgetAllocated;
+    vector<double> latitude;  // NaN when the area has no coordinates
+    vector<double> longitude;
+
+    // Number of rows (areas) stored
+    size_t size() const {
+        return id.size();
+    }
+
+    // Reserve capacity in every column
+    void reserve(size_t n) {
+        id.reserve(n);
+        name.reserve(n);
+        wasteQuantity.reserve(n);
+        wasteCategory.reserve(n);
+        areaSize.reserve(n);
+        location.reserve(n);
+        population.reserve(n);
+        lastUpdated.reserve(n);
+        wasteManagementStrategy.reserve(n);
+        environmentalImpactScore.reserve(n);
+        budgetAllocated.reserve(n);
+        latitude.reserve(n);
+        longitude.reserve(n);
+    }
+
+    // Remove every row
+    void clear() {
+        id.clear();
+        name.clear();
+        wasteQuantity.clear();
+        wasteCategory.clear();
+        areaSize.clear();
+        location.clear();
+        population.clear();
+        lastUpdated.clear();
+        wasteManagementStrategy.clear();
+        environmentalImpactScore.clear();
+        budgetAllocated.clear();
+        latitude.clear();
+        longitude.clear();
+    }
+
+    // Append an area as a new row at the end of the columns
+    void append(const Area& area) {
+        id.push_back(area.id);
+        name.push_back(area.name);
+        wasteQuantity.push_back(area.wasteQuantity);
+        wasteCategory.push_back(symbols->intern(area.wasteCategory));
+        areaSize.push_back(area.areaSize);
+        location.push_back(symbols->intern(area.location));
+        population.push_back(area.population);
+        lastUpdated.push_back(area.lastUpdated);
+        wasteManagementStrategy.push_back(symbols->intern(area.wasteManagementStrategy));
+        environmentalImpactScore.push_back(area.environmentalImpactScore);
+        budgetAllocated.push_back(area.budgetAllocated);
+        latitude.push_back(area.latitude);
+        longitude.push_back(area.longitude);
+    }
+
+    // Overwrite an existing row with the fields of an area
+    void assign(size_t row, const Area& area) {
+        id[row] = area.id;
+        name[row] = area.name;
+        wasteQuantity[row] = area.wasteQuantity;
+        wasteCategory[row] = symbols->intern(area.wasteCategory);
+        areaSize[row] = area.areaSize;
+        location[row] = symbols->intern(area.location);
+        population[row] = area.population;
+        lastUpdated[row] = area.lastUpdated;
+        wasteManagementStrategy[row] = symbols->intern(area.wasteManagementStrategy);
+        environmentalImpactScore[row] = area.environmentalImpactScore;
+        budgetAllocated[row] = area.budgetAllocated;
+        latitude[row] = area.latitude;
+        longitude[row] = area.longitude;
+    }
+
+    // Build an Area object from one row (used where a whole record is needed, e.g. display)
+    Area row(size_t row) const {
+        return Area(id[row], name[row], wasteQuantity[row], symbols->name(wasteCategory[row]), areaSize[row],
+                    symbols->name(location[row]), population[row], lastUpdated[row],
+                    symbols->name(wasteManagementStrategy[row]), environmentalImpactScore[row], budgetAllocated[row],
+                    latitude[row], longitude[row]);
+    }
+
+    // Remove a row by moving the last row into its place (keeps the columns dense)
+    void swapRemove(size_t row) {
+        size_t last = size() - 1;
+        if (row != last) {
+            id[row] = id[last];
+            name[row] = std::move(name[last]);
+            wasteQuantity[row] = wasteQuantity[last];
+            wasteCategory[row] = wasteCategory[last];
+            areaSize[row] = areaSize[last];
+            location[row] = location[last];
+            population[row] = population[last];
+            lastUpdated[row] = lastUpdated[last];
+            wasteManagementStrategy[row] = wasteManagementStrategy[last];
+            environmentalImpactScore[row] = environmentalImpactScore[last];
+            budgetAllocated[row] = budgetAllocated[last];
+            latitude[row] = latitude[last];
+            longitude[row] = longitude[last];
+        }
+        id.pop_back();
+        name.pop_back();
+        wasteQuantity.pop_back();
+        wasteCategory.pop_back();
+        areaSize.pop_back();
+        location.pop_back();
+        population.pop_back();
+        lastUpdated.pop_back();
+        wasteManagementStrategy.pop_back();
+        environmentalImpactScore.pop_back();
+        budgetAllocated.pop_back();
+        latitude.pop_back();
+        longitude.pop_back();
+    }
+};
 
-         << setw(6) << "Waste qun(t)"
+// Force a file's contents to stable storage (no-op where fsync is unavailable)
+bool syncFileToDisk(const string& filename) {
+#ifdef _WIN32
+    (void)filename;
+    return true;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
 
-         << setw(11) << "Waste Cat"
+// Read-only view of a whole file; memory-mapped where the platform supports it
+class MappedFile {
 
-         << setw(3) << "Ar Size(sq.km)"
+private:
 
-         << setw(7) << "Loc"
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    vector<char> buffer; // Fallback: file contents read into memory
+#else
+    void* mapping = nullptr;
+#endif
 
-         << setw(6) << "Popu"
+public:
 
-         << setw(10) << "Waste Manag st"
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
 
-         << setw(3) << "Environ Impact"
+    ~MappedFile() {
+        close();
+    }
 
-         << setw(12) << "Budget Alloc"
+    // Map the file, returns false if it cannot be opened
+    bool open(const string& filename) {
+        close();
+#ifdef _WIN32
+        ifstream inFile(filename, ios::binary);
+        if (!inFile.is_open()) {
+            return false;
+        }
+        buffer.assign(istreambuf_iterator<char>(inFile), istreambuf_iterator<char>());
+        bytes = buffer.data();
+        length = buffer.size();
+        return true;
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                length = 0;
+                ::close(fd);
+                return false;
+            }
+            bytes = static_cast<const char*>(mapping);
+        }
+        ::close(fd); // The mapping stays valid after the descriptor is closed
+        return true;
+#endif
+    }
 
-         << setw(25) << "Last Updated"
+    // Release the mapping
+    void close() {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (mapping != nullptr) {
+            munmap(mapping, length);
+            mapping = nullptr;
+        }
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
 
-         << endl;
+    const char* data() const {
+        return bytes;
+    }
 
+    size_t size() const {
+        return length;
+    }
+};
 
-        // Loop through all areas and display their data
+// 64-bit FNV-1a checksum used to validate binary files
+uint64_t fnv1a64(const char* data, size_t length, uint64_t hash = 14695981039346656037ULL) {
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
 
-        for (auto& entry : nodes) {
-            entry.second.displayAreaInfo(); // Call the display method for each area
+// Quote a CSV field if it contains a comma or quote (e.g. the location "Bel,Kar").
+// Line breaks cannot be written: the importer splits its input on every newline
+string csvField(const string& value) {
+    if (value.find_first_of(",\"") == string::npos) {
+        return value;
+    }
+    string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') {
+            quoted += '"'; // Double embedded quotes
         }
+        quoted += c;
     }
+    quoted += '"';
+    return quoted;
+}
 
-    // Method to sort areas by waste quantity in descending order
+// Check whether a text value can be written as a CSV field
+bool csvWritable(const string& value) {
+    return value.find_first_of("\r\n") == string::npos;
+}
 
-    void sortAreasByWaste() {
-        // Convert unordered_map to vector for sorting purposes
-        vector<pair<int, Area>> areaList(nodes.begin(), nodes.end());
+// Shortest text that reads back as exactly the same double
+string csvNumber(double value) {
+    char buffer[32];
+    auto result = to_chars(buffer, buffer + sizeof(buffer), value);
+    return string(buffer, result.ptr - buffer);
+}
 
-        // Sorting the vector based on waste quantity in descending order
+// Binary snapshot of the area registry
+//
+// Layout (native byte order; the header's endian mark rejects a file written
+// on a machine of the other byte order): a fixed SnapshotHeader followed by the payload.
+// The payload holds the numeric columns as raw arrays, then the area
+// names, the symbol dictionary and the uint32 symbol columns. String
+// lists are (count + 1) uint64 offsets followed by the characters.
+// Every section is padded to 8 bytes so arrays can be copied straight
+// out of the mapped file.
+const char SNAPSHOT_MAGIC[8] = {'W', 'M', 'S', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SNAPSHOT_VERSION = 4; // Version 2 stores category, location and strategy as symbols,
+                                     // version 3 adds latitude and longitude, version 4 the
+                                     // waste time series
+const uint32_t SNAPSHOT_ENDIAN_MARK = 0x01020304;
+const char DEFAULT_SNAPSHOT_FILE[] = "waste_areas.snap"; // Durable store opened when area management starts
+const char DEFAULT_LOG_FILE[] = "waste_areas.wal";
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianMark;
+    uint64_t rowCount;
+    uint64_t payloadSize;
+    uint64_t checksum; // FNV-1a over the payload
+};
 
-        sort(areaList.begin(), areaList.end(), [](const pair<int, Area>& a, const pair<int, Area>& b) {
-            return a.second.wasteQuantity > b.second.wasteQuantity; // Compare waste quantities
-        });
+// Append raw values to a snapshot payload, padded to 8 bytes
+template <typename T>
+void appendSnapshotArray(vector<char>& payload, const T* values, size_t count) {
+    const char* raw = reinterpret_cast<const char*>(values);
+    payload.insert(payload.end(), raw, raw + count * sizeof(T));
+    payload.resize((payload.size() + 7) & ~size_t(7), '\0');
+}
 
-        // Clear the original map and insert the sorted areas back into the map
-        nodes.clear();
-        for (auto& area : areaList) {
-            nodes[area.first] = area.second;
-        }
+// Append a string column to a snapshot payload as offsets followed by characters
+void appendSnapshotStrings(vector<char>& payload, const vector<string>& values) {
+    vector<uint64_t> offsets(values.size() + 1, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        offsets[i + 1] = offsets[i] + values[i].size();
+    }
+    appendSnapshotArray(payload, offsets.data(), offsets.size());
+    for (const string& value : values) {
+        payload.insert(payload.end(), value.begin(), value.end());
     }
+    payload.resize((payload.size() + 7) & ~size_t(7), '\0');
+}
 
-    // Method to filter and display areas based on waste category
+// Bounds-checked cursor over a snapshot payload
+struct SnapshotReader {
+    const char* cursor;
+    const char* end;
 
-    void displayAreasByCategory(const string& category) const {
-        // Displaying all areas matching the given waste category
+    // Copy 'count' values into 'out', returns false if the payload is truncated
+    template <typename T>
+    bool readArray(vector<T>& out, size_t count) {
+        if (count > static_cast<size_t>(end - cursor) / sizeof(T)) {
+            return false; // Also keeps count * sizeof(T) from overflowing
+        }
+        size_t bytes = count * sizeof(T);
+        size_t padded = (bytes + 7) & ~size_t(7);
+        if (static_cast<size_t>(end - cursor) < padded) {
+            return false;
+        }
+        out.resize(count);
+        if (bytes > 0) {
+            memcpy(out.data(), cursor, bytes);
+        }
+        cursor += padded;
+        return true;
+    }
 
-        cout << "\nAreas with waste category: " << category << "\n";
-        for (auto& entry : nodes) {
-            if (entry.second.wasteCategory == category) {
-                entry.second.displayAreaInfo(); // Display only matching areas
+    // Read a string column written by appendSnapshotStrings
+    bool readStrings(vector<string>& out, size_t count) {
+        vector<uint64_t> offsets;
+        if (count >= static_cast<size_t>(end - cursor) / sizeof(uint64_t) || !readArray(offsets, count + 1)) {
+            return false;
+        }
+        uint64_t total = offsets[count];
+        if (total > static_cast<uint64_t>(end - cursor)) {
+            return false;
+        }
+        size_t padded = (static_cast<size_t>(total) + 7) & ~size_t(7);
+        if (static_cast<size_t>(end - cursor) < padded) {
+            return false;
+        }
+        out.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (offsets[i] > offsets[i + 1] || offsets[i + 1] > total) {
+                return false;
             }
+            out[i].assign(cursor + offsets[i], cursor + offsets[i + 1]);
         }
+        cursor += padded;
+        return true;
     }
+};
 
-    // Method to update data for a specific area
-    void updateAreaData(int id) {
-        if (nodes.find(id) != nodes.end()) {
-            // If the area exists, allow updating its data
-            Area& area = nodes[id];
+// Run task(0) ... task(count - 1) on a small set of worker threads
+void runParallel(size_t count, const function<void(size_t)>& task) {
+    size_t workers = min<size_t>(count, max(1u, thread::hardware_concurrency()));
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    atomic<size_t> next(0);
+    vector<thread> threads;
+    threads.reserve(workers);
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                task(i);
+            }
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+}
 
-            cout << "Enter new data for area ID " << id << " (" << area.name << "):\n";
+// Columnar export format, for loading the registry into analytics tools
+//
+// File layout: ColumnarHeader, metadata (column table + chunk directory), then
+// chunk data. Rows are split into row groups of COLUMNAR_GROUP_ROWS and every
+// (column, row group) pair is one chunk, encoded and checksummed on its own. The
+// directory gives the offset of each chunk, so reading a few columns only
+// touches the pages of their chunks.
+const char COLUMNAR_MAGIC[8] = {'W', 'M', 'S', 'C', 'O', 'L', 'S', '\0'};
+const uint32_t COLUMNAR_VERSION = 1;
+const uint32_t COLUMNAR_GROUP_ROWS = 1 << 16;
+
+enum class ColumnType : uint8_t {
+    Int64 = 1,
+    Double = 2,
+    String = 3
+};
 
-            cout << "Enter waste quantity: ";
+enum class ColumnEncoding : uint8_t {
+    Plain = 0,       // Doubles: raw 8-byte values; strings: varint length + bytes
+    DeltaVarint = 1, // Integers: zigzag varint of the difference to the previous value
+    RunLength = 2,   // Doubles: (varint run length, raw 8-byte value) pairs
+    Dictionary = 3   // Strings: varint entry count, entries as Plain, then (varint run length, varint code) pairs
+};
 
-            cin >> area.wasteQuantity;
+struct ColumnarHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianMark;
+    uint64_t rowCount;
+    uint32_t columnCount;
+    uint32_t groupRows;
+    uint64_t chunkCount;
+    uint64_t metadataSize;     // Column table + chunk directory, right after the header
+    uint64_t metadataChecksum; // FNV-1a over the metadata
+};
 
-            cout << "Enter waste category: ";
+// Directory entry of one chunk
+struct ColumnarChunk {
+    uint32_t column;
+    uint32_t encoding;
+    uint64_t firstRow;
+    uint64_t rowCount;
+    uint64_t offset;   // From the start of the chunk data
+    uint64_t size;
+    uint64_t checksum; // FNV-1a over the chunk bytes
+};
 
-            cin.ignore(); // To ignore the newline left by previous input
+// Encoders and decoders of the column chunks
+struct ColumnarCodec {
 
-            getline(cin, area.wasteCategory);
+    static void putVarint(vector<char>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
 
-            cout << "Enter area size: ";
+    static bool getVarint(const char*& cursor, const char* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; cursor < end && shift < 64; shift += 7) {
+            uint8_t byte = static_cast<uint8_t>(*cursor++);
+            value |= uint64_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
 
-            cin >> area.areaSize;
+    static void putString(vector<char>& out, string_view value) {
+        putVarint(out, value.size());
+        out.insert(out.end(), value.begin(), value.end());
+    }
 
-            cout << "Enter location: ";
+    static bool getString(const char*& cursor, const char* end, string& value) {
+        uint64_t length;
+        if (!getVarint(cursor, end, length) || static_cast<uint64_t>(end - cursor) < length) {
+            return false;
+        }
+        value.assign(cursor, static_cast<size_t>(length));
+        cursor += length;
+        return true;
+    }
 
-            cin.ignore();
+    static ColumnEncoding encodeInt64(const vector<int64_t>& values, vector<char>& out) {
+        int64_t previous = 0;
+        for (int64_t value : values) {
+            uint64_t delta = static_cast<uint64_t>(value) - static_cast<uint64_t>(previous);
+            putVarint(out, (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63));
+            previous = value;
+        }
+        return ColumnEncoding::DeltaVarint;
+    }
 
-            getline(cin, area.location);
+    // Run-length encoding when runs of identical values make it smaller, raw values otherwise
+    static ColumnEncoding encodeDouble(const vector<double>& values, vector<char>& out) {
+        size_t runs = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            runs += i == 0 || memcmp(&values[i], &values[i - 1], sizeof(double)) != 0;
+        }
+        if (runs * (sizeof(double) + 2) >= values.size() * sizeof(double)) {
+            const char* raw = reinterpret_cast<const char*>(values.data());
+            out.insert(out.end(), raw, raw + values.size() * sizeof(double));
+            return ColumnEncoding::Plain;
+        }
+        for (size_t i = 0; i < values.size();) {
+            size_t j = i + 1;
+            while (j < values.size() && memcmp(&values[j], &values[i], sizeof(double)) == 0) {
+                ++j;
+            }
+            putVarint(out, j - i);
+            const char* raw = reinterpret_cast<const char*>(&values[i]);
+            out.insert(out.end(), raw, raw + sizeof(double));
+            i = j;
+        }
+        return ColumnEncoding::RunLength;
+    }
+
+    // Dictionary encoding when values repeat, plain strings otherwise
+    static ColumnEncoding encodeStrings(const vector<string_view>& values, vector<char>& out) {
+        unordered_map<string_view, uint64_t> codes;
+        vector<string_view> dictionary;
+        vector<uint64_t> rowCodes;
+        rowCodes.reserve(values.size());
+        for (string_view value : values) {
+            auto slot = codes.emplace(value, dictionary.size());
+            if (slot.second) {
+                dictionary.push_back(value);
+            }
+            rowCodes.push_back(slot.first->second);
+        }
+        if (dictionary.size() * 2 > values.size()) {
+            for (string_view value : values) {
+                putString(out, value);
+            }
+            return ColumnEncoding::Plain;
+        }
+        putVarint(out, dictionary.size());
+        for (string_view entry : dictionary) {
+            putString(out, entry);
+        }
+        for (size_t i = 0; i < rowCodes.size();) {
+            size_t j = i + 1;
+            while (j < rowCodes.size() && rowCodes[j] == rowCodes[i]) {
+                ++j;
+            }
+            putVarint(out, j - i);
+            putVarint(out, rowCodes[i]);
+            i = j;
+        }
+        return ColumnEncoding::Dictionary;
+    }
 
-            cout << "Enter population: ";
+    // Decoders append exactly 'count' values; they return false on malformed input
+    static bool decodeInt64(const char* cursor, const char* end, size_t count, vector<int64_t>& out) {
+        int64_t value = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t encoded;
+            if (!getVarint(cursor, end, encoded)) {
+                return false;
+            }
+            value = static_cast<int64_t>(static_cast<uint64_t>(value) + ((encoded >> 1) ^ (0 - (encoded & 1))));
+            out.push_back(value);
+        }
+        return cursor == end;
+    }
 
-            cin >> area.population;
+    static bool decodeDouble(ColumnEncoding encoding, const char* cursor, const char* end, size_t count,
+                             vector<double>& out) {
+        if (encoding == ColumnEncoding::Plain) {
+            if (static_cast<size_t>(end - cursor) != count * sizeof(double)) {
+                return false;
+            }
+            size_t first = out.size();
+            out.resize(first + count);
+            memcpy(out.data() + first, cursor, count * sizeof(double));
+            return true;
+        }
+        if (encoding != ColumnEncoding::RunLength) {
+            return false;
+        }
+        size_t target = out.size() + count;
+        while (out.size() < target) {
+            uint64_t run;
+            double value;
+            if (!getVarint(cursor, end, run) || run > target - out.size() ||
+                static_cast<size_t>(end - cursor) < sizeof(double)) {
+                return false;
+            }
+            memcpy(&value, cursor, sizeof(double));
+            cursor += sizeof(double);
+            out.insert(out.end(), static_cast<size_t>(run), value);
+        }
+        return cursor == end;
+    }
 
-            cout << "Enter waste management strategy: ";
+    static bool decodeStrings(ColumnEncoding encoding, const char* cursor, const char* end, size_t count,
+                              vector<string>& out) {
+        size_t target = out.size() + count;
+        if (encoding == ColumnEncoding::Plain) {
+            string value;
+            while (out.size() < target) {
+                if (!getString(cursor, end, value)) {
+                    return false;
+                }
+                out.push_back(value);
+            }
+            return cursor == end;
+        }
+        if (encoding != ColumnEncoding::Dictionary) {
+            return false;
+        }
+        uint64_t entries;
+        if (!getVarint(cursor, end, entries) || entries > static_cast<uint64_t>(end - cursor)) {
+            return false;
+        }
+        vector<string> dictionary(static_cast<size_t>(entries));
+        for (string& entry : dictionary) {
+            if (!getString(cursor, end, entry)) {
+                return false;
+            }
+        }
+        while (out.size() < target) {
+            uint64_t run, code;
+            if (!getVarint(cursor, end, run) || !getVarint(cursor, end, code) || run > target - out.size() ||
+                code >= dictionary.size()) {
+                return false;
+            }
+            out.insert(out.end(), static_cast<size_t>(run), dictionary[code]);
+        }
+        return cursor == end;
+    }
+};
 
-            cin.ignore();
+// Writer of columnar files. Each column supplies a function that encodes rows
+// [begin, end) into a chunk; the chunks are encoded in parallel
+class ColumnarWriter {
 
-            getline(cin, area.wasteManagementStrategy);
+public:
 
-            cout << "Enter environmental impact score: ";
+    using ChunkEncoder = function<ColumnEncoding(size_t begin, size_t end, vector<char>& out)>;
 
-            cin >> area.environmentalImpactScore;
+private:
 
-            cout << "Enter budget allocated: ";
+    struct Column {
+        string name;
+        ColumnType type;
+        ChunkEncoder encode;
+    };
 
-            cin >> area.budgetAllocated;
+    vector<Column> columns;
 
-            area.lastUpdated = time(0); // Update the timestamp for when the data was updated
+public:
 
-            cout << "Area data updated successfully!\n";
-        } else {
-            cout << "Area ID " << id << " not found!\n";
+    void addColumn(const string& name, ColumnType type, ChunkEncoder encode) {
+        columns.push_back({name, type, std::move(encode)});
+    }
+
+    // Write 'rowCount' rows of every column; on failure 'error' says why
+    bool write(const string& filename, size_t rowCount, string& error) const {
+        size_t groups = (rowCount + COLUMNAR_GROUP_ROWS - 1) / COLUMNAR_GROUP_ROWS;
+        size_t chunkCount = groups * columns.size();
+        vector<vector<char>> data(chunkCount);
+        vector<ColumnarChunk> directory(chunkCount);
+        runParallel(chunkCount, [&](size_t i) {
+            size_t column = i / groups, group = i % groups;
+            size_t begin = group * COLUMNAR_GROUP_ROWS, end = min(rowCount, begin + COLUMNAR_GROUP_ROWS);
+            ColumnarChunk& chunk = directory[i];
+            chunk.column = static_cast<uint32_t>(column);
+            chunk.encoding = static_cast<uint32_t>(columns[column].encode(begin, end, data[i]));
+            chunk.firstRow = begin;
+            chunk.rowCount = end - begin;
+            chunk.size = data[i].size();
+            chunk.checksum = fnv1a64(data[i].data(), data[i].size());
+        });
+        uint64_t offset = 0;
+        for (ColumnarChunk& chunk : directory) {
+            chunk.offset = offset;
+            offset += chunk.size;
+        }
+
+        vector<char> metadata;
+        for (const Column& column : columns) {
+            metadata.push_back(static_cast<char>(column.type));
+            ColumnarCodec::putString(metadata, column.name);
+        }
+        const char* raw = reinterpret_cast<const char*>(directory.data());
+        metadata.insert(metadata.end(), raw, raw + directory.size() * sizeof(ColumnarChunk));
+
+        ColumnarHeader header;
+        memcpy(header.magic, COLUMNAR_MAGIC, sizeof(header.magic));
+        header.version = COLUMNAR_VERSION;
+        header.endianMark = SNAPSHOT_ENDIAN_MARK;
+        header.rowCount = rowCount;
+        header.columnCount = static_cast<uint32_t>(columns.size());
+        header.groupRows = COLUMNAR_GROUP_ROWS;
+        header.chunkCount = chunkCount;
+        header.metadataSize = metadata.size();
+        header.metadataChecksum = fnv1a64(metadata.data(), metadata.size());
+
+        // Same temporary file + rename as the snapshot, so readers never see a partial file
+        string tempName = filename + ".tmp";
+        {
+            ofstream outFile(tempName, ios::binary | ios::trunc);
+            if (!outFile.is_open()) {
+                error = "cannot open " + tempName;
+                return false;
+            }
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            outFile.write(metadata.data(), metadata.size());
+            for (const vector<char>& chunk : data) {
+                outFile.write(chunk.data(), chunk.size());
+            }
+            if (!outFile) {
+                error = "cannot write " + tempName;
+                return false;
+            }
+        }
+        if (!syncFileToDisk(tempName)) {
+            error = "cannot sync " + tempName;
+            return false;
+        }
+        if (rename(tempName.c_str(), filename.c_str()) != 0) {
+            error = "cannot rename " + tempName + " to " + filename;
+            return false;
         }
+        return true;
     }
+};
 
-    // Method to delete an area by its ID
-
-    void deleteArea(int id) {
-
-        if (nodes.find(id) != nodes.end()) {
+// Self-contained reader of columnar files. Only the header and directory are
+// parsed on open; each read decodes the chunks of one column and nothing else
+class ColumnarReader {
 
-            // If area exists, erase it from the map
+private:
 
-            nodes.erase(id);
+    MappedFile file;
+    ColumnarHeader header;
+    const char* chunkData = nullptr;
+    vector<string> names;
+    vector<ColumnType> types;
+    vector<vector<ColumnarChunk>> chunksOf; // Chunks of each column, in row order
+    size_t decodedBytes = 0;
+
+    // Validate a column's chunks and pass each one to 'decode'
+    template <typename Decode>
+    bool forEachChunk(size_t column, ColumnType type, string& error, const Decode& decode) {
+        if (column >= names.size() || types[column] != type) {
+            error = "no such column of the requested type";
+            return false;
+        }
+        for (const ColumnarChunk& chunk : chunksOf[column]) {
+            const char* begin = chunkData + chunk.offset;
+            if (fnv1a64(begin, chunk.size) != chunk.checksum) {
+                error = "checksum mismatch in column " + names[column];
+                return false;
+            }
+            if (!decode(static_cast<ColumnEncoding>(chunk.encoding), begin, begin + chunk.size,
+                        static_cast<size_t>(chunk.rowCount))) {
+                error = "corrupted chunk in column " + names[column];
+                return false;
+            }
+            decodedBytes += chunk.size;
+        }
+        return true;
+    }
 
-            cout << "Area ID " << id << " has been deleted.\n";
-        } else {
-            cout << "Area ID " << id << " not found!\n";
+    // Check that a decoded column holds exactly rowCount() values
+    bool hasAllRows(size_t column, size_t decoded, string& error) const {
+        if (decoded != rowCount()) {
+            error = "column " + names[column] + " decoded to " + to_string(decoded) + " rows instead of " +
+                    to_string(rowCount());
+            return false;
         }
+        return true;
     }
 
-    // Method to save data to a file
+public:
+
+    bool open(const string& filename, string& error) {
+        if (!file.open(filename)) {
+            error = "cannot open " + filename;
+            return false;
+        }
+        if (file.size() < sizeof(header)) {
+            error = "file is truncated";
+            return false;
+        }
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, COLUMNAR_MAGIC, sizeof(header.magic)) != 0 ||
+            header.endianMark != SNAPSHOT_ENDIAN_MARK) {
+            error = "not a columnar file";
+            return false;
+        }
+        if (header.version != COLUMNAR_VERSION) {
+            error = "unsupported columnar version " + to_string(header.version);
+            return false;
+        }
+        const char* metadata = file.data() + sizeof(header);
+        if (file.size() - sizeof(header) < header.metadataSize ||
+            fnv1a64(metadata, header.metadataSize) != header.metadataChecksum) {
+            error = "metadata is corrupted";
+            return false;
+        }
+
+        // Column table, then the fixed-size chunk directory
+        const char* cursor = metadata;
+        const char* end = metadata + header.metadataSize;
+        for (uint32_t i = 0; i < header.columnCount; ++i) {
+            string name;
+            if (cursor >= end) {
+                error = "metadata is corrupted";
+                return false;
+            }
+            types.push_back(static_cast<ColumnType>(*cursor++));
+            if (!ColumnarCodec::getString(cursor, end, name)) {
+                error = "metadata is corrupted";
+                return false;
+            }
+            names.push_back(name);
+        }
+        if (static_cast<size_t>(end - cursor) != header.chunkCount * sizeof(ColumnarChunk)) {
+            error = "metadata is corrupted";
+            return false;
+        }
+        chunkData = end;
+        size_t dataSize = file.size() - sizeof(header) - header.metadataSize;
+        chunksOf.assign(names.size(), {});
+        vector<uint64_t> rowsOf(names.size(), 0);
+        uint64_t dataEnd = 0; // End of the previous chunk; chunks are stored in directory order
+        for (uint64_t i = 0; i < header.chunkCount; ++i) {
+            ColumnarChunk chunk;
+            memcpy(&chunk, cursor + i * sizeof(ColumnarChunk), sizeof(chunk));
+            // Each chunk starts where the previous one ended or later, lies inside the
+            // file and continues its column's rows, so no chunk is read out of bounds
+            // or decoded twice
+            if (chunk.column >= names.size() || chunk.offset < dataEnd || chunk.offset > dataSize ||
+                chunk.size > dataSize - chunk.offset || chunk.firstRow != rowsOf[chunk.column] ||
+                chunk.rowCount > header.rowCount - chunk.firstRow) {
+                error = "metadata is corrupted";
+                return false;
+            }
+            dataEnd = chunk.offset + chunk.size;
+            rowsOf[chunk.column] += chunk.rowCount;
+            chunksOf[chunk.column].push_back(chunk);
+        }
+
+        // Every column must hold exactly the rows the header announces
+        for (size_t column = 0; column < names.size(); ++column) {
+            uint64_t rows = rowsOf[column];
+            if (rows != header.rowCount) {
+                error = "column " + names[column] + " holds " + to_string(rows) + " rows instead of " +
+                        to_string(header.rowCount);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t rowCount() const {
+        return static_cast<size_t>(header.rowCount);
+    }
+
+    size_t columnCount() const {
+        return names.size();
+    }
+
+    const string& columnName(size_t column) const {
+        return names[column];
+    }
+
+    ColumnType columnType(size_t column) const {
+        return types[column];
+    }
+
+    // Index of a column by name, or -1
+    int findColumn(const string& name) const {
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    // Chunk bytes decoded so far (the rest of the file is never read)
+    size_t bytesDecoded() const {
+        return decodedBytes;
+    }
+
+    size_t fileSize() const {
+        return file.size();
+    }
+
+    bool readInt64(size_t column, vector<int64_t>& out, string& error) {
+        out.clear();
+        out.reserve(rowCount());
+        return forEachChunk(column, ColumnType::Int64, error,
+                            [&](ColumnEncoding encoding, const char* begin, const char* end, size_t count) {
+            return encoding == ColumnEncoding::DeltaVarint && ColumnarCodec::decodeInt64(begin, end, count, out);
+        }) && hasAllRows(column, out.size(), error);
+    }
+
+    bool readDouble(size_t column, vector<double>& out, string& error) {
+        out.clear();
+        out.reserve(rowCount());
+        return forEachChunk(column, ColumnType::Double, error,
+                            [&](ColumnEncoding encoding, const char* begin, const char* end, size_t count) {
+            return ColumnarCodec::decodeDouble(encoding, begin, end, count, out);
+        }) && hasAllRows(column, out.size(), error);
+    }
+
+    bool readString(size_t column, vector<string>& out, string& error) {
+        out.clear();
+        out.reserve(rowCount());
+        return forEachChunk(column, ColumnType::String, error,
+                            [&](ColumnEncoding encoding, const char* begin, const char* end, size_t count) {
+            return ColumnarCodec::decodeStrings(encoding, begin, end, count, out);
+        }) && hasAllRows(column, out.size(), error);
+    }
+};
+
+// Read a subset of the columns of a columnar file and display the first rows
+void displayColumnarColumns(const string& filename, const vector<string>& columnNames, size_t maxRows) {
+    ColumnarReader reader;
+    string error;
+    if (!reader.open(filename, error)) {
+        cout << "Error reading " << filename << ": " << error << "\n";
+        return;
+    }
+
+    // Decode only the requested columns, as text for display
+    vector<vector<string>> text;
+    vector<string> headers;
+    vector<ReportTable::Align> alignment;
+    size_t rows = min(maxRows, reader.rowCount());
+    for (const string& name : columnNames) {
+        int column = reader.findColumn(name);
+        if (column < 0) {
+            cout << "No column named " << name << "\n";
+            continue;
+        }
+        vector<string> cells;
+        bool ok = true;
+        if (reader.columnType(column) == ColumnType::Int64) {
+            vector<int64_t> values;
+            ok = reader.readInt64(column, values, error);
+            for (size_t row = 0; ok && row < rows; ++row) {
+                cells.push_back(to_string(values[row]));
+            }
+        } else if (reader.columnType(column) == ColumnType::Double) {
+            vector<double> values;
+            ok = reader.readDouble(column, values, error);
+            for (size_t row = 0; ok && row < rows; ++row) {
+                char buffer[32];
+                snprintf(buffer, sizeof(buffer), "%g", values[row]);
+                cells.push_back(buffer);
+            }
+        } else {
+            ok = reader.readString(column, cells, error);
+            cells.resize(min(cells.size(), rows));
+        }
+        if (!ok) {
+            cout << "Error reading column " << name << ": " << error << "\n";
+            return;
+        }
+        headers.push_back(name);
+        alignment.push_back(reader.columnType(column) == ColumnType::String ? ReportTable::LEFT : ReportTable::RIGHT);
+        text.push_back(std::move(cells));
+    }
+
+    cout << "\n" << reader.rowCount() << " rows, " << reader.columnCount() << " columns; decoded "
+         << reader.bytesDecoded() << " of " << reader.fileSize() << " bytes for " << headers.size() << " columns\n";
+    if (headers.empty()) {
+        return;
+    }
+    ReportTable table(headers, alignment);
+    for (size_t row = 0; row < rows; ++row) {
+        for (const vector<string>& cells : text) {
+            table.cell(cells[row]);
+        }
+    }
+    table.render(cout);
+}
+
+// One area row parsed from CSV; string fields point into the file buffer
+struct CsvAreaRow {
+    size_t line;
+    int id;
+    string_view name;
+    double wasteQuantity;
+    string_view wasteCategory;
+    double areaSize;
+    string_view location;
+    int population;
+    string_view wasteManagementStrategy;
+    double environmentalImpactScore;
+    double budgetAllocated;
+    time_t lastUpdated;
+    double latitude;  // NaN when the optional coordinate fields are missing or empty
+    double longitude;
+    unsigned escapedFields; // Bit i set when text field i contains doubled quotes
+};
+
+// Malformed row reported by the CSV parser
+struct CsvImportError {
+    size_t line;
+    string message;
+};
+
+// Result of parsing one chunk of the file
+struct CsvChunkResult {
+    vector<CsvAreaRow> rows;
+    vector<CsvImportError> errors;
+    size_t lineCount = 0;
+};
+
+// Turn a parsed text field into a string, collapsing doubled quotes if needed
+string csvFieldText(string_view field, bool escaped) {
+    if (!escaped) {
+        return string(field);
+    }
+    string text;
+    text.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        text += field[i];
+        if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return text;
+}
+
+// Streaming parser for area CSV files written by Graph::saveToFile
+//
+// The file is mapped into memory and split into chunks at line boundaries.
+// Each chunk is parsed on its own thread without copying: fields are views
+// into the buffer and numbers are read with from_chars. Malformed rows are
+// collected with their line numbers instead of aborting the import.
+class AreaCsvParser {
+
+private:
+
+    // Split the next field off 'cursor'; 'more' tells whether a comma followed it.
+    // Returns false if the quoting is broken
+    static bool nextField(const char*& cursor, const char* end, string_view& field, bool& escaped, bool& more) {
+        escaped = false;
+        more = false;
+        if (cursor < end && *cursor == '"') {
+            const char* start = ++cursor;
+            while (cursor < end) {
+                if (*cursor == '"') {
+                    if (cursor + 1 < end && cursor[1] == '"') {
+                        escaped = true;
+                        cursor += 2;
+                        continue;
+                    }
+                    break;
+                }
+                ++cursor;
+            }
+            if (cursor >= end) {
+                return false; // Missing closing quote
+            }
+            field = string_view(start, cursor - start);
+            ++cursor;
+            if (cursor < end && *cursor != ',') {
+                return false; // Text after the closing quote
+            }
+        } else {
+            const char* start = cursor;
+            while (cursor < end && *cursor != ',') {
+                ++cursor;
+            }
+            field = string_view(start, cursor - start);
+        }
+        if (cursor < end) {
+            ++cursor; // Skip the comma
+            more = true;
+        }
+        return true;
+    }
+
+    // Parse a whole field as a number. "nan" and "inf" are rejected: they would
+    // break the ordered indexes and poison the running totals
+    template <typename T>
+    static bool parseNumber(string_view field, T& value) {
+        const char* first = field.data();
+        const char* last = field.data() + field.size();
+        auto result = from_chars(first, last, value);
+        return result.ec == errc() && result.ptr == last && isfinite(static_cast<double>(value));
+    }
+
+    // Parse one line into 'row', returns an error message or nullptr
+    static const char* parseLine(const char* begin, const char* end, CsvAreaRow& row) {
+        // 11 fields, optionally followed by latitude and longitude
+        const int FIELD_COUNT = 11;
+        const int GEO_FIELD_COUNT = 13;
+        string_view fields[GEO_FIELD_COUNT];
+        bool escaped[GEO_FIELD_COUNT];
+        const char* cursor = begin;
+        int fieldCount = 0;
+        for (bool more = true; more; ++fieldCount) {
+            if (fieldCount == GEO_FIELD_COUNT) {
+                return "expected 11 or 13 fields";
+            }
+            if (!nextField(cursor, end, fields[fieldCount], escaped[fieldCount], more)) {
+                return "unterminated quoted field";
+            }
+        }
+        if (fieldCount != FIELD_COUNT && fieldCount != GEO_FIELD_COUNT) {
+            return "expected 11 or 13 fields";
+        }
+
+        long long lastUpdated;
+        if (!parseNumber(fields[0], row.id)) return "invalid area ID";
+        if (!parseNumber(fields[2], row.wasteQuantity)) return "invalid waste quantity";
+        if (!parseNumber(fields[4], row.areaSize)) return "invalid area size";
+        if (!parseNumber(fields[6], row.population)) return "invalid population";
+        if (!parseNumber(fields[8], row.environmentalImpactScore)) return "invalid environmental impact score";
+        if (!parseNumber(fields[9], row.budgetAllocated)) return "invalid budget";
+        if (!parseNumber(fields[10], lastUpdated)) return "invalid last updated timestamp";
+        row.latitude = row.longitude = numeric_limits<double>::quiet_NaN();
+        if (fieldCount == GEO_FIELD_COUNT && !(fields[11].empty() && fields[12].empty())) {
+            if (!parseNumber(fields[11], row.latitude) || fabs(row.latitude) > 90) return "invalid latitude";
+            if (!parseNumber(fields[12], row.longitude) || fabs(row.longitude) > 180) return "invalid longitude";
+        }
+
+        row.name = fields[1];
+        row.wasteCategory = fields[3];
+        row.location = fields[5];
+        row.wasteManagementStrategy = fields[7];
+        row.lastUpdated = static_cast<time_t>(lastUpdated);
+        row.escapedFields = (escaped[1] ? 1u : 0u) | (escaped[3] ? 2u : 0u) |
+                            (escaped[5] ? 4u : 0u) | (escaped[7] ? 8u : 0u);
+        return nullptr;
+    }
+
+    // Parse every line in [begin, end); line numbers are relative to the chunk
+    static void parseChunk(const char* begin, const char* end, CsvChunkResult& result) {
+        result.rows.reserve((end - begin) / 64);
+        const char* lineStart = begin;
+        while (lineStart < end) {
+            const char* lineEnd = static_cast<const char*>(memchr(lineStart, '\n', end - lineStart));
+            if (lineEnd == nullptr) {
+                lineEnd = end;
+            }
+            ++result.lineCount;
+            const char* contentEnd = lineEnd;
+            if (contentEnd > lineStart && contentEnd[-1] == '\r') {
+                --contentEnd;
+            }
+            if (contentEnd > lineStart) { // Blank lines are skipped
+                CsvAreaRow row;
+                const char* error = parseLine(lineStart, contentEnd, row);
+                if (error == nullptr) {
+                    row.line = result.lineCount;
+                    result.rows.push_back(row);
+                } else {
+                    result.errors.push_back({result.lineCount, error});
+                }
+            }
+            lineStart = lineEnd + 1;
+        }
+    }
+
+public:
+
+    // Files smaller than this are parsed on a single thread
+    static const size_t MIN_CHUNK_BYTES = 1 << 20;
+
+    // Parse a mapped file into chunks; row and error line numbers are absolute (1-based)
+    static vector<CsvChunkResult> parse(const char* data, size_t size) {
+        size_t threads = max(1u, thread::hardware_concurrency());
+        size_t chunkCount = max<size_t>(1, min(threads, size / MIN_CHUNK_BYTES));
+
+        // Cut the buffer into chunks that end on a line boundary
+        vector<const char*> bounds;
+        bounds.push_back(data);
+        for (size_t i = 1; i < chunkCount; ++i) {
+            const char* cut = data + size * i / chunkCount;
+            if (cut <= bounds.back()) {
+                continue;
+            }
+            const char* newline = static_cast<const char*>(memchr(cut, '\n', data + size - cut));
+            if (newline == nullptr) {
+                break;
+            }
+            bounds.push_back(newline + 1);
+        }
+        bounds.push_back(data + size);
+
+        vector<CsvChunkResult> chunks(bounds.size() - 1);
+        runParallel(chunks.size(), [&](size_t i) {
+            parseChunk(bounds[i], bounds[i + 1], chunks[i]);
+        });
+
+        // Convert chunk-relative line numbers into file line numbers
+        size_t firstLine = 0;
+        for (CsvChunkResult& chunk : chunks) {
+            for (CsvAreaRow& row : chunk.rows) {
+                row.line += firstLine;
+            }
+            for (CsvImportError& error : chunk.errors) {
+                error.line += firstLine;
+            }
+            firstLine += chunk.lineCount;
+        }
+        return chunks;
+    }
+};
+
+// Secondary index from a field value to the IDs of the areas holding that value
+template <typename Key>
+class SecondaryIndex {
+
+private:
+
+    unordered_map<Key, unordered_set<int>> postings; // Field value -> area IDs
+
+public:
+
+    // Record that area 'id' holds 'key'
+    void add(const Key& key, int id) {
+        postings[key].insert(id);
+    }
+
+    // Forget that area 'id' holds 'key'; drops the key once no area uses it
+    void remove(const Key& key, int id) {
+        auto it = postings.find(key);
+        if (it == postings.end()) {
+            return;
+        }
+        it->second.erase(id);
+        if (it->second.empty()) {
+            postings.erase(it);
+        }
+    }
+
+    // IDs of the areas holding 'key', or nullptr if there are none
+    const unordered_set<int>* find(const Key& key) const {
+        auto it = postings.find(key);
+        return it == postings.end() ? nullptr : &it->second;
+    }
+
+    // Number of distinct values in the index
+    size_t keyCount() const {
+        return postings.size();
+    }
+
+    void clear() {
+        postings.clear();
+    }
+};
+
+// Numeric area fields that can carry an ordered index
+enum class AreaField {
+    WasteQuantity,
+    AreaSize,
+    Population,
+    EnvironmentalImpactScore,
+    BudgetAllocated,
+    LastUpdated
+};
+
+const size_t AREA_FIELD_COUNT = 6;
+
+// Ordered index over one numeric field: (value, area ID) pairs kept sorted
+class OrderedIndex {
+
+private:
+
+    set<pair<double, int>> entries;
+
+public:
+
+    using const_iterator = set<pair<double, int>>::const_iterator;
+    using const_reverse_iterator = set<pair<double, int>>::const_reverse_iterator;
+
+    void add(double value, int id) {
+        entries.insert({value, id});
+    }
+
+    void remove(double value, int id) {
+        entries.erase({value, id});
+    }
+
+    void clear() {
+        entries.clear();
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    // Ascending iteration
+    const_iterator begin() const {
+        return entries.begin();
+    }
+
+    const_iterator end() const {
+        return entries.end();
+    }
+
+    // Descending iteration
+    const_reverse_iterator rbegin() const {
+        return entries.rbegin();
+    }
+
+    const_reverse_iterator rend() const {
+        return entries.rend();
+    }
+
+    // IDs of the 'n' areas with the largest values, largest first
+    vector<int> top(size_t n) const {
+        vector<int> ids;
+        for (auto it = entries.rbegin(); it != entries.rend() && ids.size() < n; ++it) {
+            ids.push_back(it->second);
+        }
+        return ids;
+    }
+
+    // IDs of the areas with value > threshold, largest first
+    vector<int> above(double threshold) const {
+        vector<int> ids;
+        auto stop = entries.upper_bound({threshold, numeric_limits<int>::max()});
+        for (auto it = entries.rbegin(); it != entries.rend() && it.base() != stop; ++it) {
+            ids.push_back(it->second);
+        }
+        return ids;
+    }
+
+    // IDs of the areas with low <= value <= high, in ascending order of value
+    vector<int> range(double low, double high) const {
+        vector<int> ids;
+        auto it = entries.lower_bound({low, numeric_limits<int>::min()});
+        for (; it != entries.end() && it->first <= high; ++it) {
+            ids.push_back(it->second);
+        }
+        return ids;
+    }
+};
+
+// Running sum that supports removing values without accumulating rounding drift
+// (Neumaier compensated summation)
+struct RunningSum {
+    double sum = 0;
+    double compensation = 0;
+
+    void add(double value) {
+        double total = sum + value;
+        if (fabs(sum) >= fabs(value)) {
+            compensation += (sum - total) + value;
+        } else {
+            compensation += (value - total) + sum;
+        }
+        sum = total;
+    }
+
+    void subtract(double value) {
+        add(-value);
+    }
+
+    double value() const {
+        return sum + compensation;
+    }
+};
+
+constexpr double PI = 3.14159265358979323846; // M_PI is not standard C++
+constexpr double EARTH_RADIUS_KM = 6371.0088;    // Mean Earth radius
+
+// Great-circle distance in kilometres between two points (haversine formula)
+inline double geoDistanceKm(double latitude1, double longitude1, double latitude2, double longitude2) {
+    const double toRadians = PI / 180;
+    double dLatitude = (latitude2 - latitude1) * toRadians;
+    double dLongitude = (longitude2 - longitude1) * toRadians;
+    double a = sin(dLatitude / 2) * sin(dLatitude / 2) +
+               cos(latitude1 * toRadians) * cos(latitude2 * toRadians) * sin(dLongitude / 2) * sin(dLongitude / 2);
+    return 2 * EARTH_RADIUS_KM * asin(min(1.0, sqrt(a)));
+}
+
+// Uniform latitude/longitude grid over area coordinates, used for radius and
+// nearest-neighbour queries. Each cell is 'cellDegrees' on a side (0.01 degrees is
+// about 1.1 km), so a query only visits the cells around the query point.
+// Queries do not wrap around the antimeridian
+//
+// This is a flat grid, not a tree: add and remove are O(1) and a query costs the
+// cells it covers plus the points in them, with no O(log n) bound. That fits a
+// city registry whose areas are spread over a few hundred cells. If many areas
+// crowd into a few cells, or a query covers a huge empty region, a KD-tree or
+// R-tree would do better. The full-scan fallbacks below cap the worst case at
+// one pass over the occupied cells
+class GeoGridIndex {
+
+private:
+
+    struct Point {
+        int id;
+        double latitude;
+        double longitude;
+    };
+
+    double cellDegrees;
+    unordered_map<uint64_t, vector<Point>> cells; // Occupied cells only
+    unordered_map<int, uint64_t> cellOf;          // Area ID -> cell key
+    int minRow = numeric_limits<int>::max(), maxRow = numeric_limits<int>::min();
+    int minColumn = numeric_limits<int>::max(), maxColumn = numeric_limits<int>::min();
+
+    int rowOf(double latitude) const {
+        return static_cast<int>(floor((latitude + 90) / cellDegrees));
+    }
+
+    int columnOf(double longitude) const {
+        return static_cast<int>(floor((longitude + 180) / cellDegrees));
+    }
+
+    static uint64_t key(int row, int column) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32) | static_cast<uint32_t>(column);
+    }
+
+    // Kilometres per degree of latitude on the mean Earth sphere
+    static constexpr double KM_PER_DEGREE = 111.19508;
+
+    // Lower bound on the distance from the query point to any indexed point outside
+    // the square of rings 0..ring around its cell. Such a point lies beyond one of
+    // the square's edges that still has occupied cells behind it. Past a parallel it
+    // is at least the latitude gap away. Past a meridian it is at least the distance
+    // to that meridian, asin(cos(latitude) * sin(longitude gap)), reaching the pole
+    // distance once the gap is 90 degrees
+    double outsideRingKm(double latitude, double longitude, int ring) const {
+        const double toRadians = PI / 180;
+        int centerRow = rowOf(latitude), centerColumn = columnOf(longitude);
+        double bound = numeric_limits<double>::infinity();
+        if (centerRow + ring < maxRow) {
+            double gap = (centerRow + ring + 1) * cellDegrees - 90 - latitude;
+            bound = min(bound, EARTH_RADIUS_KM * gap * toRadians);
+        }
+        if (centerRow - ring > minRow) {
+            double gap = latitude + 90 - (centerRow - ring) * cellDegrees;
+            bound = min(bound, EARTH_RADIUS_KM * gap * toRadians);
+        }
+        double meridianGaps[2] = {-1, -1};
+        if (centerColumn + ring < maxColumn) {
+            meridianGaps[0] = (centerColumn + ring + 1) * cellDegrees - 180 - longitude;
+        }
+        if (centerColumn - ring > minColumn) {
+            meridianGaps[1] = longitude + 180 - (centerColumn - ring) * cellDegrees;
+        }
+        for (double gap : meridianGaps) {
+            if (gap >= 0) {
+                double crossTrack = cos(latitude * toRadians) * sin(min(gap, 90.0) * toRadians);
+                bound = min(bound, EARTH_RADIUS_KM * asin(min(1.0, crossTrack)));
+            }
+        }
+        return max(0.0, bound);
+    }
+
+    // Add every point of a cell within 'radiusKm' of the query point to 'out'
+    void collect(const vector<Point>& cell, double latitude, double longitude, double radiusKm,
+                 vector<pair<double, int>>& out) const {
+        for (const Point& point : cell) {
+            double distance = geoDistanceKm(latitude, longitude, point.latitude, point.longitude);
+            if (distance <= radiusKm) {
+                out.push_back({distance, point.id});
+            }
+        }
+    }
+
+public:
+
+    explicit GeoGridIndex(double cellDegrees = 0.01) : cellDegrees(cellDegrees) {}
+
+    void add(int id, double latitude, double longitude) {
+        int row = rowOf(latitude), column = columnOf(longitude);
+        uint64_t cell = key(row, column);
+        cells[cell].push_back({id, latitude, longitude});
+        cellOf[id] = cell;
+        minRow = min(minRow, row);
+        maxRow = max(maxRow, row);
+        minColumn = min(minColumn, column);
+        maxColumn = max(maxColumn, column);
+    }
+
+    void remove(int id) {
+        auto it = cellOf.find(id);
+        if (it == cellOf.end()) {
+            return;
+        }
+        auto cell = cells.find(it->second);
+        vector<Point>& points = cell->second;
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (points[i].id == id) {
+                points[i] = points.back();
+                points.pop_back();
+                break;
+            }
+        }
+        if (points.empty()) {
+            cells.erase(cell);
+        }
+        cellOf.erase(it);
+    }
+
+    void clear() {
+        cells.clear();
+        cellOf.clear();
+        minRow = minColumn = numeric_limits<int>::max();
+        maxRow = maxColumn = numeric_limits<int>::min();
+    }
+
+    size_t size() const {
+        return cellOf.size();
+    }
+
+    // (distance in km, area ID) of every point within 'radiusKm', nearest first
+    vector<pair<double, int>> within(double latitude, double longitude, double radiusKm) const {
+        vector<pair<double, int>> found;
+        if (cells.empty() || radiusKm < 0) {
+            return found;
+        }
+
+        // Cells covering the bounding box of the circle; longitude degrees shrink towards the poles
+        double latitudeSpan = radiusKm / KM_PER_DEGREE;
+        double widest = min(89.9, fabs(latitude) + latitudeSpan) * PI / 180;
+        double longitudeSpan = min(360.0, latitudeSpan / cos(widest));
+        int firstRow = max(minRow, rowOf(latitude - latitudeSpan));
+        int lastRow = min(maxRow, rowOf(latitude + latitudeSpan));
+        int firstColumn = max(minColumn, columnOf(longitude - longitudeSpan));
+        int lastColumn = min(maxColumn, columnOf(longitude + longitudeSpan));
+
+        if (firstRow <= lastRow && firstColumn <= lastColumn) {
+            double boxCells = double(lastRow - firstRow + 1) * double(lastColumn - firstColumn + 1);
+            if (boxCells > cells.size()) {
+                // Fewer occupied cells than cells in the box: scan the occupied ones
+                for (const auto& cell : cells) {
+                    collect(cell.second, latitude, longitude, radiusKm, found);
+                }
+            } else {
+                for (int row = firstRow; row <= lastRow; ++row) {
+                    for (int column = firstColumn; column <= lastColumn; ++column) {
+                        auto cell = cells.find(key(row, column));
+                        if (cell != cells.end()) {
+                            collect(cell->second, latitude, longitude, radiusKm, found);
+                        }
+                    }
+                }
+            }
+        }
+        sort(found.begin(), found.end());
+        return found;
+    }
+
+    // (distance in km, area ID) of the 'k' points nearest to the query point, nearest first
+    vector<pair<double, int>> nearest(double latitude, double longitude, size_t k) const {
+        vector<pair<double, int>> best; // Max-heap on distance holding the k best so far
+        if (k == 0 || cells.empty()) {
+            return best;
+        }
+        int centerRow = rowOf(latitude), centerColumn = columnOf(longitude);
+        int lastRing = max(max(centerRow - minRow, maxRow - centerRow), max(centerColumn - minColumn, maxColumn - centerColumn));
+        auto consider = [&](const vector<Point>& cell) {
+            for (const Point& point : cell) {
+                pair<double, int> candidate(geoDistanceKm(latitude, longitude, point.latitude, point.longitude), point.id);
+                if (best.size() < k) {
+                    best.push_back(candidate);
+                    push_heap(best.begin(), best.end());
+                } else if (candidate < best.front()) {
+                    pop_heap(best.begin(), best.end());
+                    best.back() = candidate;
+                    push_heap(best.begin(), best.end());
+                }
+            }
+        };
+
+        // Visit square rings of cells around the query cell until no unvisited cell can hold a closer point
+        for (int ring = 0; ring <= max(0, lastRing); ++ring) {
+            if (8.0 * ring > cells.size()) {
+                // The ring has more cells than the grid has occupied cells: finish with a full scan
+                best.clear();
+                for (const auto& cell : cells) {
+                    consider(cell.second);
+                }
+                break;
+            }
+            for (int row = centerRow - ring; row <= centerRow + ring; ++row) {
+                bool edgeRow = row == centerRow - ring || row == centerRow + ring;
+                for (int column = centerColumn - ring; column <= centerColumn + ring;
+                     column += edgeRow || ring == 0 ? 1 : 2 * ring) {
+                    auto cell = cells.find(key(row, column));
+                    if (cell != cells.end()) {
+                        consider(cell->second);
+                    }
+                }
+            }
+
+            // Stop once no point outside rings 0..ring can be closer than the k-th best
+            if (best.size() == k && best.front().first <= outsideRingKm(latitude, longitude, ring)) {
+                break;
+            }
+        }
+        sort_heap(best.begin(), best.end());
+        return best;
+    }
+};
+
+// One waste quantity reading reported by a bin sensor
+struct SensorReading {
+    int areaId;
+    double wasteQuantity; // Tons
+    time_t timestamp;
+};
+
+// Counters reported by Graph::ingestReadings
+struct IngestStats {
+    size_t received = 0;    // Readings passed in
+    size_t applied = 0;     // Areas actually updated
+    size_t coalesced = 0;   // Readings superseded by a newer reading for the same area in the batch
+    size_t unknownArea = 0; // Readings for area IDs that do not exist
+    size_t invalid = 0;     // Readings whose waste quantity is not a finite number
+    size_t stale = 0;       // Readings older than the area's last update
+    size_t alerts = 0;      // Anomaly alerts raised (spikes, drops and stale areas)
+    double seconds = 0;     // Time spent applying the readings
+
+    // Readings processed per second
+    double throughput() const {
+        return seconds > 0 ? received / seconds : 0;
+    }
+
+    // Accumulate another batch into these counters
+    void add(const IngestStats& other) {
+        received += other.received;
+        applied += other.applied;
+        coalesced += other.coalesced;
+        unknownArea += other.unknownArea;
+        invalid += other.invalid;
+        stale += other.stale;
+        alerts += other.alerts;
+        seconds += other.seconds;
+    }
+
+    // Print the counters
+    void display() const {
+        cout << "Readings received: " << received << "\n"
+             << "Areas updated: " << applied << "\n"
+             << "Coalesced: " << coalesced << "\n"
+             << "Unknown area: " << unknownArea << "\n"
+             << "Invalid quantity: " << invalid << "\n"
+             << "Stale: " << stale << "\n"
+             << "Anomaly alerts: " << alerts << "\n"
+             << "Throughput: " << static_cast<long long>(throughput()) << " readings/s\n";
+    }
+};
+
+// Read "areaId,wasteQuantity,timestamp" lines from a file; returns the number of malformed lines
+size_t loadSensorReadings(const string& filename, vector<SensorReading>& readings) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        return 0;
+    }
+    size_t malformed = 0;
+    const char* cursor = file.data();
+    const char* end = file.data() + file.size();
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        const char* contentEnd = (lineEnd > cursor && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+        if (contentEnd > cursor) {
+            SensorReading reading;
+            long long timestamp;
+            auto id = from_chars(cursor, contentEnd, reading.areaId);
+            bool ok = id.ec == errc() && id.ptr < contentEnd && *id.ptr == ',';
+            auto quantity = ok ? from_chars(id.ptr + 1, contentEnd, reading.wasteQuantity) : id;
+            ok = ok && quantity.ec == errc() && quantity.ptr < contentEnd && *quantity.ptr == ',';
+            auto time = ok ? from_chars(quantity.ptr + 1, contentEnd, timestamp) : quantity;
+            ok = ok && time.ec == errc() && time.ptr == contentEnd && isfinite(reading.wasteQuantity);
+            if (ok) {
+                reading.timestamp = static_cast<time_t>(timestamp);
+                readings.push_back(reading);
+            } else {
+                ++malformed;
+            }
+        }
+        cursor = lineEnd + 1;
+    }
+    return malformed;
+}
+
+// Summary of the readings that fall into one hour or one day
+struct RollupBucket {
+    time_t start;  // Start of the hour/day (UTC)
+    size_t count;  // Number of readings
+    double sum;
+    double min;
+    double max;
+    double last;   // Most recent reading in the bucket
+
+    double mean() const {
+        return count > 0 ? sum / count : 0;
+    }
+};
+
+// Chunk header of a time series as stored in a snapshot
+struct SnapshotChunk {
+    int64_t firstTime;
+    int64_t lastTime;
+    int64_t firstValue;
+    int64_t lastValue;
+    uint64_t count;
+    uint64_t byteCount;
+};
+
+// Embedded time-series store of waste quantity readings, keyed by area ID
+//
+// Raw points are appended to fixed-size chunks. Inside a chunk each point is
+// stored as varint(time delta) + zigzag varint(value delta), with values
+// quantized to kilograms. Hourly and daily rollups are updated on every append
+// so range questions over days never decode the raw chunks.
+class WasteTimeSeries {
+
+public:
+
+    static const size_t POINTS_PER_CHUNK = 256;
+    static constexpr double VALUE_SCALE = 1000.0; // Stored resolution: 1 kg = 1/1000 ton
+    static const time_t HOUR = 60 * 60;
+    static const time_t DAY = 24 * 60 * 60;
+
+private:
+
+    // Block of compressed points; the first point is kept in the header
+    struct Chunk {
+        time_t firstTime;
+        time_t lastTime;
+        int64_t firstValue;
+        int64_t lastValue;
+        uint32_t count;
+        vector<uint8_t> bytes; // Encoded deltas of points 2..count
+    };
+
+    struct Series {
+        vector<Chunk> chunks;
+        vector<RollupBucket> hourly;
+        vector<RollupBucket> daily;
+    };
+
+    unordered_map<int, Series> series;
+    size_t totalPoints = 0;
+
+    static void putVarint(vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t getVarint(const uint8_t*& cursor) {
+        uint64_t value = 0;
+        int shift = 0;
+        while (*cursor & 0x80) {
+            value |= uint64_t(*cursor++ & 0x7f) << shift;
+            shift += 7;
+        }
+        value |= uint64_t(*cursor++) << shift;
+        return value;
+    }
+
+    static uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    // Check that 'size' bytes hold exactly the 2 * (count - 1) varints of a chunk,
+    // so decoding a chunk loaded from a file never reads past its bytes
+    static bool validChunk(const uint8_t* bytes, size_t size, uint64_t count) {
+        uint64_t varints = 0;
+        size_t length = 0;
+        for (size_t i = 0; i < size; ++i) {
+            if (++length > 10) {
+                return false; // Longer than any 64-bit varint
+            }
+            if (!(bytes[i] & 0x80)) {
+                ++varints;
+                length = 0;
+            }
+        }
+        return size == 0 ? count == 1 : !(bytes[size - 1] & 0x80) && varints == 2 * (count - 1);
+    }
+
+    static int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // Add a reading to the rollup bucket starting at 'start'
+    static void addToRollup(vector<RollupBucket>& buckets, time_t start, double value) {
+        if (buckets.empty() || buckets.back().start != start) {
+            buckets.push_back({start, 0, 0, value, value, value});
+        }
+        RollupBucket& bucket = buckets.back();
+        ++bucket.count;
+        bucket.sum += value;
+        bucket.min = min(bucket.min, value);
+        bucket.max = max(bucket.max, value);
+        bucket.last = value;
+    }
+
+    // Buckets of one rollup whose start lies in [from, to]
+    static vector<RollupBucket> bucketRange(const vector<RollupBucket>& buckets, time_t from, time_t to) {
+        auto first = lower_bound(buckets.begin(), buckets.end(), from,
+                                 [](const RollupBucket& bucket, time_t t) { return bucket.start < t; });
+        vector<RollupBucket> result;
+        for (auto it = first; it != buckets.end() && it->start <= to; ++it) {
+            result.push_back(*it);
+        }
+        return result;
+    }
+
+public:
+
+    // Append a reading; returns false if it is older than the area's last reading
+    bool append(int areaId, time_t timestamp, double wasteQuantity) {
+        Series& s = series[areaId];
+        int64_t value = llround(wasteQuantity * VALUE_SCALE);
+        if (!s.chunks.empty() && timestamp < s.chunks.back().lastTime) {
+            return false;
+        }
+
+        if (s.chunks.empty() || s.chunks.back().count == POINTS_PER_CHUNK) {
+            s.chunks.push_back({timestamp, timestamp, value, value, 1, {}});
+        } else {
+            Chunk& chunk = s.chunks.back();
+            putVarint(chunk.bytes, static_cast<uint64_t>(timestamp - chunk.lastTime));
+            putVarint(chunk.bytes, zigzag(value - chunk.lastValue));
+            chunk.lastTime = timestamp;
+            chunk.lastValue = value;
+            ++chunk.count;
+        }
+        addToRollup(s.hourly, timestamp - timestamp % HOUR, wasteQuantity);
+        addToRollup(s.daily, timestamp - timestamp % DAY, wasteQuantity);
+        ++totalPoints;
+        return true;
+    }
+
+    // Drop all history of an area
+    void erase(int areaId) {
+        auto it = series.find(areaId);
+        if (it == series.end()) {
+            return;
+        }
+        for (const Chunk& chunk : it->second.chunks) {
+            totalPoints -= chunk.count;
+        }
+        series.erase(it);
+    }
+
+    void clear() {
+        series.clear();
+        totalPoints = 0;
+    }
+
+    // Raw readings of an area with from <= time <= to, decoded from the chunks
+    vector<pair<time_t, double>> points(int areaId, time_t from, time_t to) const {
+        vector<pair<time_t, double>> result;
+        auto it = series.find(areaId);
+        if (it == series.end()) {
+            return result;
+        }
+        for (const Chunk& chunk : it->second.chunks) {
+            if (chunk.lastTime < from || chunk.firstTime > to) {
+                continue; // Skip chunks outside the range without decoding them
+            }
+            time_t t = chunk.firstTime;
+            int64_t value = chunk.firstValue;
+            const uint8_t* cursor = chunk.bytes.data();
+            for (uint32_t i = 0; i < chunk.count; ++i) {
+                if (i > 0) {
+                    t += static_cast<time_t>(getVarint(cursor));
+                    value += unzigzag(getVarint(cursor));
+                }
+                if (t >= from && t <= to) {
+                    result.push_back({t, value / VALUE_SCALE});
+                }
+            }
+        }
+        return result;
+    }
+
+    // Hourly rollups of an area for hours starting in [from, to]
+    vector<RollupBucket> hourly(int areaId, time_t from, time_t to) const {
+        auto it = series.find(areaId);
+        return it == series.end() ? vector<RollupBucket>() : bucketRange(it->second.hourly, from, to);
+    }
+
+    // Daily rollups of an area for days starting in [from, to]
+    vector<RollupBucket> daily(int areaId, time_t from, time_t to) const {
+        auto it = series.find(areaId);
+        return it == series.end() ? vector<RollupBucket>() : bucketRange(it->second.daily, from, to);
+    }
+
+    // Number of raw points stored
+    size_t pointCount() const {
+        return totalPoints;
+    }
+
+    // Append every series to a snapshot payload: the area IDs and per-area counts,
+    // then all chunk headers, the encoded chunk bytes and the rollup buckets
+    void appendToSnapshot(vector<char>& payload) const {
+        vector<int32_t> ids;
+        vector<uint64_t> chunkCounts, hourlyCounts, dailyCounts;
+        vector<SnapshotChunk> headers;
+        vector<uint8_t> bytes;
+        vector<RollupBucket> hourlyBuckets, dailyBuckets;
+        for (const auto& entry : series) {
+            const Series& s = entry.second;
+            ids.push_back(entry.first);
+            chunkCounts.push_back(s.chunks.size());
+            hourlyCounts.push_back(s.hourly.size());
+            dailyCounts.push_back(s.daily.size());
+            for (const Chunk& chunk : s.chunks) {
+                headers.push_back({chunk.firstTime, chunk.lastTime, chunk.firstValue, chunk.lastValue, chunk.count,
+                                   chunk.bytes.size()});
+                bytes.insert(bytes.end(), chunk.bytes.begin(), chunk.bytes.end());
+            }
+            hourlyBuckets.insert(hourlyBuckets.end(), s.hourly.begin(), s.hourly.end());
+            dailyBuckets.insert(dailyBuckets.end(), s.daily.begin(), s.daily.end());
+        }
+        uint64_t counts[] = {ids.size(), headers.size(), bytes.size(), hourlyBuckets.size(), dailyBuckets.size()};
+        appendSnapshotArray(payload, counts, 5);
+        appendSnapshotArray(payload, ids.data(), ids.size());
+        appendSnapshotArray(payload, chunkCounts.data(), chunkCounts.size());
+        appendSnapshotArray(payload, hourlyCounts.data(), hourlyCounts.size());
+        appendSnapshotArray(payload, dailyCounts.data(), dailyCounts.size());
+        appendSnapshotArray(payload, headers.data(), headers.size());
+        appendSnapshotArray(payload, bytes.data(), bytes.size());
+        appendSnapshotArray(payload, hourlyBuckets.data(), hourlyBuckets.size());
+        appendSnapshotArray(payload, dailyBuckets.data(), dailyBuckets.size());
+    }
+
+    // Replace every series with the ones written by appendToSnapshot. Returns false,
+    // leaving the series unchanged, if the section is truncated or inconsistent
+    bool readFromSnapshot(SnapshotReader& reader) {
+        vector<uint64_t> counts;
+        vector<int32_t> ids;
+        vector<uint64_t> chunkCounts, hourlyCounts, dailyCounts;
+        vector<SnapshotChunk> headers;
+        vector<uint8_t> bytes;
+        vector<RollupBucket> hourlyBuckets, dailyBuckets;
+        if (!reader.readArray(counts, 5) || !reader.readArray(ids, counts[0]) ||
+            !reader.readArray(chunkCounts, counts[0]) || !reader.readArray(hourlyCounts, counts[0]) ||
+            !reader.readArray(dailyCounts, counts[0]) || !reader.readArray(headers, counts[1]) ||
+            !reader.readArray(bytes, counts[2]) || !reader.readArray(hourlyBuckets, counts[3]) ||
+            !reader.readArray(dailyBuckets, counts[4])) {
+            return false;
+        }
+
+        unordered_map<int, Series> loaded;
+        size_t points = 0, nextChunk = 0, nextByte = 0, nextHourly = 0, nextDaily = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (chunkCounts[i] > headers.size() - nextChunk || hourlyCounts[i] > hourlyBuckets.size() - nextHourly ||
+                dailyCounts[i] > dailyBuckets.size() - nextDaily) {
+                return false;
+            }
+            Series& s = loaded[ids[i]];
+            for (uint64_t c = 0; c < chunkCounts[i]; ++c) {
+                const SnapshotChunk& header = headers[nextChunk++];
+                if (header.count == 0 || header.count > POINTS_PER_CHUNK || header.byteCount > bytes.size() - nextByte ||
+                    !validChunk(bytes.data() + nextByte, header.byteCount, header.count)) {
+                    return false;
+                }
+                const uint8_t* begin = bytes.data() + nextByte;
+                s.chunks.push_back({static_cast<time_t>(header.firstTime), static_cast<time_t>(header.lastTime),
+                                    header.firstValue, header.lastValue, static_cast<uint32_t>(header.count),
+                                    vector<uint8_t>(begin, begin + header.byteCount)});
+                nextByte += header.byteCount;
+                points += header.count;
+            }
+            s.hourly.assign(hourlyBuckets.begin() + nextHourly, hourlyBuckets.begin() + nextHourly + hourlyCounts[i]);
+            s.daily.assign(dailyBuckets.begin() + nextDaily, dailyBuckets.begin() + nextDaily + dailyCounts[i]);
+            nextHourly += hourlyCounts[i];
+            nextDaily += dailyCounts[i];
+        }
+        if (loaded.size() != ids.size() || nextChunk != headers.size() || nextByte != bytes.size() ||
+            nextHourly != hourlyBuckets.size() || nextDaily != dailyBuckets.size()) {
+            return false;
+        }
+        series = std::move(loaded);
+        totalPoints = points;
+        return true;
+    }
+
+    // Bytes used by the compressed point data
+    size_t compressedBytes() const {
+        size_t bytes = 0;
+        for (const auto& entry : series) {
+            for (const Chunk& chunk : entry.second.chunks) {
+                bytes += sizeof(Chunk) + chunk.bytes.size();
+            }
+        }
+        return bytes;
+    }
+};
+
+// Forecasting models, from the least to the most history they need
+enum class ForecastModel : uint8_t {
+    Naive,       // Repeat the last value
+    Holt,        // Level + trend (double exponential smoothing)
+    HoltWinters  // Level + trend + additive weekly season
+};
+
+inline const char* forecastModelName(ForecastModel model) {
+    switch (model) {
+        case ForecastModel::Naive: return "Naive";
+        case ForecastModel::Holt: return "Holt";
+        case ForecastModel::HoltWinters: return "Holt-Winters";
+    }
+    return "";
+}
+
+// Fitted model and forecasts of one area's daily mean waste quantity
+struct WasteForecast {
+    static const int HORIZON_DAYS = 7;
+
+    int areaId = 0;
+    ForecastModel model = ForecastModel::Naive;
+    size_t historyDays = 0;          // Length of the daily series the model was fitted on
+    double alpha = 0, beta = 0, gamma = 0;
+    double rmse = 0;                 // One-step-ahead error over the history
+    array<double, HORIZON_DAYS> daily{}; // Forecast for each of the next HORIZON_DAYS days
+
+    double nextDay() const {
+        return daily[0];
+    }
+
+    double nextWeek() const {
+        return daily[HORIZON_DAYS - 1];
+    }
+};
+
+// Exponential smoothing forecaster for daily series
+//
+// The smoothing parameters are chosen per series by a small grid search that
+// minimizes the one-step-ahead squared error, so refitting is a fixed number of
+// passes over each series and needs no iterative optimizer.
+class WasteForecaster {
+
+public:
+
+    static const int SEASON_DAYS = 7;
+
+private:
+
+    static constexpr double ALPHAS[] = {0.2, 0.4, 0.6, 0.8};
+    static constexpr double BETAS[] = {0.05, 0.15, 0.3};
+    static constexpr double GAMMAS[] = {0.05, 0.2};
+
+    // Run Holt (season == false) or additive Holt-Winters over 'x'; returns the SSE of the
+    // one-step-ahead forecasts and, if 'out' is set, the forecasts after the last point
+    static double smooth(const vector<double>& x, bool season, double alpha, double beta, double gamma,
+                         array<double, WasteForecast::HORIZON_DAYS>* out) {
+        const int m = SEASON_DAYS;
+        size_t n = x.size();
+        double level, trend;
+        array<double, SEASON_DAYS> seasonal{};
+        size_t first;
+        if (season) {
+            // Initial level and trend from the first two seasons, season from the first
+            double firstMean = 0, secondMean = 0;
+            for (int i = 0; i < m; ++i) {
+                firstMean += x[i] / m;
+                secondMean += x[m + i] / m;
+            }
+            level = firstMean;
+            trend = (secondMean - firstMean) / m;
+            for (int i = 0; i < m; ++i) {
+                seasonal[i] = x[i] - firstMean;
+            }
+            first = m;
+        } else {
+            level = x[0];
+            trend = x[1] - x[0];
+            first = 1;
+        }
+
+        double sse = 0;
+        for (size_t t = first; t < n; ++t) {
+            double& s = seasonal[t % m];
+            double forecast = level + trend + (season ? s : 0);
+            double error = x[t] - forecast;
+            sse += error * error;
+            double previousLevel = level;
+            level = alpha * (x[t] - (season ? s : 0)) + (1 - alpha) * (level + trend);
+            trend = beta * (level - previousLevel) + (1 - beta) * trend;
+            if (season) {
+                s = gamma * (x[t] - level) + (1 - gamma) * s;
+            }
+        }
+        if (out != nullptr) {
+            for (int h = 1; h <= WasteForecast::HORIZON_DAYS; ++h) {
+                double value = level + h * trend + (season ? seasonal[(n + h - 1) % m] : 0);
+                (*out)[h - 1] = max(0.0, value); // Waste quantities are never negative
+            }
+        }
+        return sse;
+    }
+
+public:
+
+    // Fit the best model the history allows and forecast the following days.
+    // 'history' holds one value per day, oldest first, and must not be empty
+    static WasteForecast fit(const vector<double>& history) {
+        WasteForecast forecast;
+        forecast.historyDays = history.size();
+        size_t n = history.size();
+        if (n < 3) {
+            forecast.daily.fill(history.back());
+            return forecast;
+        }
+
+        bool season = n >= 2 * SEASON_DAYS;
+        forecast.model = season ? ForecastModel::HoltWinters : ForecastModel::Holt;
+        double bestSse = numeric_limits<double>::infinity();
+        for (double alpha : ALPHAS) {
+            for (double beta : BETAS) {
+                for (double gamma : GAMMAS) {
+                    double sse = smooth(history, season, alpha, beta, gamma, nullptr);
+                    if (sse < bestSse) {
+                        bestSse = sse;
+                        forecast.alpha = alpha;
+                        forecast.beta = beta;
+                        forecast.gamma = season ? gamma : 0;
+                    }
+                    if (!season) {
+                        break; // Holt has no seasonal parameter
+                    }
+                }
+            }
+        }
+        smooth(history, season, forecast.alpha, forecast.beta, forecast.gamma, &forecast.daily);
+        forecast.rmse = sqrt(bestSse / (n - (season ? SEASON_DAYS : 1)));
+        return forecast;
+    }
+};
+
+// Kinds of anomaly raised by WasteAnomalyDetector
+enum class AnomalyType : uint8_t {
+    Spike, // Reading far above the area's recent level (e.g. illegal dumping)
+    Drop,  // Reading far below the area's recent level (e.g. a faulty sensor)
+    Stale  // No reading for longer than the staleness threshold
+};
+
+inline const char* anomalyTypeName(AnomalyType type) {
+    switch (type) {
+        case AnomalyType::Spike: return "Spike";
+        case AnomalyType::Drop: return "Drop";
+        case AnomalyType::Stale: return "Stale";
+    }
+    return "";
+}
+
+struct WasteAlert {
+    int areaId;
+    AnomalyType type;
+    time_t time;     // Time of the reading, or the time the area was found stale
+    double value;    // Reading (Spike/Drop) or last reading (Stale)
+    double expected; // EWMA mean before the reading
+    double score;    // Z-score (Spike/Drop) or days since the last reading (Stale)
+};
+
+// Streaming anomaly detector over area waste readings
+//
+// Each area keeps constant state: an exponentially weighted mean and variance of
+// its readings and the time it was last seen. A reading whose z-score against
+// that mean exceeds the threshold raises a Spike or Drop alert. Staleness
+// deadlines live in a hashed timer wheel: every area sits in the slot of its
+// deadline tick, so a reading reschedules its area in O(1) and advancing the
+// clock only visits the slots of the elapsed ticks.
+class WasteAnomalyDetector {
+
+public:
+
+    struct Settings {
+        double alpha = 0.05;         // EWMA weight of the newest reading
+        double zThreshold = 4.0;     // |z| above which a reading is anomalous
+        uint32_t warmupReadings = 20; // Readings needed before spikes are reported
+        double staleAfterDays = 3;   // Same unit as Area::getDaysSinceLastUpdate
+        time_t tickSeconds = 60 * 60;
+    };
+
+    static const size_t WHEEL_SLOTS = 256;
+
+private:
+
+    static const uint32_t NOT_SCHEDULED = numeric_limits<uint32_t>::max();
+
+    struct AreaStream {
+        double mean = 0;
+        double variance = 0;
+        double lastValue = 0;
+        time_t lastSeen = 0;
+        int64_t deadlineTick = 0;
+        uint32_t count = 0;
+        uint32_t slot = NOT_SCHEDULED; // Wheel slot holding the area, if its staleness is armed
+        uint32_t position = 0;         // Index of the area inside the slot
+    };
+
+    Settings settings;
+    unordered_map<int, AreaStream> streams;
+    array<vector<int>, WHEEL_SLOTS> wheel;
+    int64_t currentTick = numeric_limits<int64_t>::min(); // Last tick processed by advance()
+
+    int64_t tickOf(time_t t) const {
+        return static_cast<int64_t>(t / settings.tickSeconds);
+    }
+
+    void unschedule(AreaStream& stream) {
+        if (stream.slot == NOT_SCHEDULED) {
+            return;
+        }
+        vector<int>& slot = wheel[stream.slot];
+        int moved = slot.back();
+        slot[stream.position] = moved;
+        streams[moved].position = stream.position;
+        slot.pop_back();
+        stream.slot = NOT_SCHEDULED;
+    }
+
+    // Arm the staleness deadline of an area from its last reading
+    void schedule(int areaId, AreaStream& stream) {
+        unschedule(stream);
+        time_t deadline = stream.lastSeen + static_cast<time_t>(settings.staleAfterDays * 24 * 60 * 60);
+        stream.deadlineTick = max(tickOf(deadline) + 1, currentTick + 1); // Deadlines already past fire next tick
+        stream.slot = static_cast<uint32_t>(stream.deadlineTick % WHEEL_SLOTS);
+        stream.position = static_cast<uint32_t>(wheel[stream.slot].size());
+        wheel[stream.slot].push_back(areaId);
+    }
+
+public:
+
+    WasteAnomalyDetector() = default;
+
+    explicit WasteAnomalyDetector(const Settings& settings) : settings(settings) {}
+
+    const Settings& currentSettings() const {
+        return settings;
+    }
+
+    // Start (or restart) tracking an area from a known value, without raising alerts
+    void track(int areaId, double value, time_t timestamp) {
+        AreaStream& stream = streams[areaId];
+        stream.mean = stream.lastValue = value;
+        stream.variance = 0;
+        stream.count = 1;
+        stream.lastSeen = timestamp;
+        schedule(areaId, stream);
+    }
+
+    // Stop tracking an area
+    void forget(int areaId) {
+        auto it = streams.find(areaId);
+        if (it != streams.end()) {
+            unschedule(it->second);
+            streams.erase(it);
+        }
+    }
+
+    void clear() {
+        streams.clear();
+        for (vector<int>& slot : wheel) {
+            slot.clear();
+        }
+    }
+
+    // Feed one reading; appends an alert to 'alerts' if it is a spike or drop
+    void observe(int areaId, double value, time_t timestamp, vector<WasteAlert>& alerts) {
+        auto it = streams.find(areaId);
+        if (it == streams.end()) {
+            track(areaId, value, timestamp);
+            return;
+        }
+        AreaStream& stream = it->second;
+        double deviation = value - stream.mean;
+        double spread = sqrt(stream.variance);
+        if (stream.count >= settings.warmupReadings && spread > 0) {
+            double z = deviation / spread;
+            if (fabs(z) > settings.zThreshold) {
+                alerts.push_back({areaId, z > 0 ? AnomalyType::Spike : AnomalyType::Drop, timestamp, value,
+                                  stream.mean, z});
+            }
+        }
+
+        // Exponentially weighted mean and variance (West / Finch incremental form). Until
+        // 1/alpha readings have been seen the weight 1/count is used instead, which makes
+        // the first estimates the plain running mean and variance
+        ++stream.count;
+        double weight = max(settings.alpha, 1.0 / stream.count);
+        double increment = weight * deviation;
+        stream.mean += increment;
+        stream.variance = (1 - weight) * (stream.variance + deviation * increment);
+        stream.lastValue = value;
+        if (timestamp >= stream.lastSeen) {
+            stream.lastSeen = timestamp;
+            schedule(areaId, stream);
+        }
+    }
+
+    // Move the clock to 'now' and append a Stale alert for every area whose deadline
+    // has passed. A stale area is reported once and re-armed by its next reading
+    void advance(time_t now, vector<WasteAlert>& alerts) {
+        int64_t target = tickOf(now);
+        if (currentTick == numeric_limits<int64_t>::min() || target - currentTick > int64_t(WHEEL_SLOTS)) {
+            currentTick = target - WHEEL_SLOTS; // Visiting one full turn of the wheel covers every slot
+        }
+        for (int64_t tick = currentTick + 1; tick <= target; ++tick) {
+            vector<int>& slot = wheel[tick % WHEEL_SLOTS];
+            for (size_t i = 0; i < slot.size();) {
+                AreaStream& stream = streams[slot[i]];
+                if (stream.deadlineTick > target) {
+                    ++i; // Due in a later turn of the wheel
+                    continue;
+                }
+                alerts.push_back({slot[i], AnomalyType::Stale, now, stream.lastValue, stream.mean,
+                                  difftime(now, stream.lastSeen) / (60 * 60 * 24)});
+                unschedule(stream); // Moves the slot's last entry into position i
+            }
+        }
+        currentTick = max(currentTick, target);
+    }
+
+    size_t trackedAreas() const {
+        return streams.size();
+    }
+};
+
+// Per-area metrics for the whole registry, row-aligned with the area columns
+struct AreaMetrics {
+    vector<int> id;
+    vector<double> wasteDensity;        // Area::calculateWasteDensity
+    vector<double> environmentalImpact; // Area::calculateEnvironmentalImpact
+    vector<double> wastePerCapita;      // Area::calculateWastePerCapita
+};
+
+// Batch kernels over contiguous columns. Each uses exactly the expression of the
+// matching Area method so the results are bit-identical; the plain loops over
+// raw arrays let the compiler vectorize them
+
+void wasteDensityKernel(const double* waste, const double* size, double* out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = size[i] > 0 ? waste[i] / size[i] : 0;
+    }
+}
+
+void environmentalImpactKernel(const double* score, const double* waste, double* out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = score[i] * (waste[i] / 1000);
+    }
+}
+
+void wastePerCapitaKernel(const double* waste, const int* population, double* out, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = population[i] > 0 ? waste[i] / population[i] : 0;
+    }
+}
+
+// Budget optimization model
+//
+// Spending b on area i is assumed to remove a concave share of its environmental
+// impact I_i:  reduction_i(b) = I_i * (1 - exp(-b / s_i)),  where the scale s_i
+// (the spend that removes about 63% of the impact) is proportional to the
+// area's waste quantity. Maximizing the total reduction for a fixed total budget
+// is a concave resource allocation problem; its optimum gives every area the
+// same marginal gain lambda, except where a lower bound (per-area minimum) or a
+// per-category cap binds:
+//
+//   b_i(lambda) = max(min_i, s_i * ln(g_i / max(lambda, lambda_c)))   with g_i = I_i / s_i
+//
+// where lambda_c is the multiplier at which category c exactly meets its cap.
+// Every lambda_c and the global lambda are found by bisection, each step being
+// one parallel pass over the areas.
+
+// Inputs of the solver, one entry per area
+struct BudgetProblem {
+    vector<double> gain;     // g_i: marginal reduction of the first unit spent (I_i / s_i)
+    vector<double> scale;    // s_i
+    vector<double> minimum;  // min_i
+    vector<int> group;       // Index into groupCap, or -1 for an uncapped area
+    vector<double> groupCap; // Cap on the total budget of each capped group
+    double totalBudget = 0;
+};
+
+// Output of the solver
+struct BudgetSolution {
+    vector<double> budget;   // b_i
+    double lambda = 0;       // Marginal gain shared by every unconstrained area
+    double unallocated = 0;  // Budget left over because every area is capped
+    string error;            // Non-empty if the problem is infeasible
+};
+
+class BudgetSolver {
+
+private:
+
+    static const size_t BLOCK_ROWS = 1 << 14;
+    static const int BISECTION_STEPS = 100;
+
+    const BudgetProblem& problem;
+    vector<double> groupLambda; // lambda_c of each capped group (0 while the cap does not bind)
+
+    // Budget of one area for a global multiplier
+    double areaBudget(size_t i, double lambda) const {
+        double effective = problem.group[i] >= 0 ? max(lambda, groupLambda[problem.group[i]]) : lambda;
+        if (problem.gain[i] <= effective || problem.scale[i] <= 0) {
+            return problem.minimum[i];
+        }
+        return max(problem.minimum[i], problem.scale[i] * log(problem.gain[i] / effective));
+    }
+
+    // Sum of 'value(i)' over the rows in 'rows' (all rows if null), evaluated in parallel blocks
+    template <typename Value>
+    static double parallelSum(size_t count, const vector<size_t>* rows, const Value& value) {
+        size_t blocks = (count + BLOCK_ROWS - 1) / BLOCK_ROWS;
+        vector<double> partial(blocks, 0.0);
+        runParallel(blocks, [&](size_t block) {
+            size_t end = min(count, (block + 1) * BLOCK_ROWS);
+            double sum = 0;
+            for (size_t k = block * BLOCK_ROWS; k < end; ++k) {
+                sum += value(rows != nullptr ? (*rows)[k] : k);
+            }
+            partial[block] = sum;
+        });
+        double total = 0;
+        for (double sum : partial) {
+            total += sum;
+        }
+        return total;
+    }
+
+    // Smallest lambda (to bisection precision) with total(lambda) <= target; total must be non-increasing
+    template <typename Total>
+    static double solveLambda(double highest, double target, const Total& total) {
+        if (total(highest) > target) {
+            return highest; // Even the minimums exceed the target; the caller reports it
+        }
+        // Walk down in log space until the budget would be exceeded
+        double logHigh = log(highest), logLow = logHigh;
+        for (double step = 1; total(exp(logLow)) <= target; step *= 2) {
+            if (exp(logHigh - step) == 0) {
+                return exp(logLow); // The target cannot be reached: every area is capped
+            }
+            logLow = logHigh - step;
+        }
+        for (int i = 0; i < BISECTION_STEPS; ++i) {
+            double middle = (logLow + logHigh) / 2;
+            if (total(exp(middle)) <= target) {
+                logHigh = middle;
+            } else {
+                logLow = middle;
+            }
+        }
+        return exp(logHigh);
+    }
+
+public:
+
+    explicit BudgetSolver(const BudgetProblem& problem) : problem(problem) {}
+
+    BudgetSolution solve() {
+        BudgetSolution solution;
+        size_t n = problem.gain.size();
+        double highestGain = numeric_limits<double>::min();
+        for (double gain : problem.gain) {
+            highestGain = max(highestGain, gain);
+        }
+
+        // Areas of each capped group, and the multiplier at which each cap binds
+        vector<vector<size_t>> groupRows(problem.groupCap.size());
+        for (size_t i = 0; i < n; ++i) {
+            if (problem.group[i] >= 0) {
+                groupRows[problem.group[i]].push_back(i);
+            }
+        }
+        groupLambda.assign(problem.groupCap.size(), 0.0);
+        double minimumTotal = parallelSum(n, nullptr, [&](size_t i) { return problem.minimum[i]; });
+        for (size_t c = 0; c < groupRows.size(); ++c) {
+            const vector<size_t>& rows = groupRows[c];
+            auto groupTotal = [&](double lambda) {
+                return parallelSum(rows.size(), &rows, [&](size_t i) { return areaBudget(i, lambda); });
+            };
+            if (groupTotal(highestGain) > problem.groupCap[c]) {
+                solution.error = "the per-area minimums of a category exceed its cap";
+                return solution;
+            }
+            groupLambda[c] = solveLambda(highestGain, problem.groupCap[c], groupTotal);
+        }
+        if (minimumTotal > problem.totalBudget) {
+            solution.error = "the per-area minimums exceed the total budget";
+            return solution;
+        }
+
+        // Global multiplier, with the group multipliers acting as floors
+        auto total = [&](double lambda) {
+            return parallelSum(n, nullptr, [&](size_t i) { return areaBudget(i, lambda); });
+        };
+        solution.lambda = solveLambda(highestGain, problem.totalBudget, total);
+        solution.budget.resize(n);
+        runParallel((n + BLOCK_ROWS - 1) / BLOCK_ROWS, [&](size_t block) {
+            size_t end = min(n, (block + 1) * BLOCK_ROWS);
+            for (size_t i = block * BLOCK_ROWS; i < end; ++i) {
+                solution.budget[i] = areaBudget(i, solution.lambda);
+            }
+        });
+        solution.unallocated = max(0.0, problem.totalBudget - total(solution.lambda));
+        return solution;
+    }
+};
+
+// Settings of Graph::optimizeBudget
+struct BudgetPlanOptions {
+    double costPerTon = 50;                     // Spend per ton of waste that removes ~63% of an area's impact
+    double defaultMinimum = 0;                  // Minimum budget of every area
+    unordered_map<int, double> areaMinimum;     // Area ID -> minimum, overrides defaultMinimum
+    unordered_map<string, double> categoryCap;  // Waste category -> cap on its total budget
+};
+
+// Proposed allocation and how it differs from the current one
+struct BudgetPlan {
+    vector<int> id;
+    vector<double> current;
+    vector<double> proposed;
+    double currentReduction = 0;  // Modelled impact reduction of the current allocation
+    double proposedReduction = 0; // Modelled impact reduction of the proposed allocation
+    double unallocated = 0;
+    double seconds = 0;
+    string error;
+};
+
+// Kinds of area mutations recorded in the write-ahead log
+enum class WalOp : uint8_t {
+    Upsert = 1,  // Full area record (add or update)
+    Erase = 2,   // Area deleted
+    Reading = 3  // Sensor reading: new waste quantity and timestamp
+};
+
+// One decoded log record
+struct WalRecord {
+    WalOp op;
+    Area area; // Upsert: all fields; Erase and Reading: id (Reading also wasteQuantity, lastUpdated)
+};
+
+// Append-only write-ahead log of area mutations
+//
+// Each record is framed as uint32 payload length + uint64 FNV-1a checksum +
+// payload. Records are staged in memory and written with a single write +
+// fsync per group (group commit): a group is flushed when it holds
+// GROUP_COMMIT_RECORDS records, when its oldest record is older than
+// GROUP_COMMIT_INTERVAL (a background thread flushes a group that stays idle),
+// or when commit() or close() is called. A crash can therefore
+// lose at most the records of the last uncommitted group; replay stops at the
+// first torn or corrupted record.
+class AreaWriteAheadLog {
+
+public:
+
+    static const size_t GROUP_COMMIT_RECORDS = 512;
+    static constexpr chrono::milliseconds GROUP_COMMIT_INTERVAL{20};
+
+private:
+
+    string path;
+#ifdef _WIN32
+    ofstream file;
+#else
+    int fd = -1;
+#endif
+    vector<char> pending;       // Encoded records not yet written
+    size_t pendingRecords = 0;
+    chrono::steady_clock::time_point oldestPending;
+    size_t committedGroups = 0;
+    size_t committedRecords = 0;
+    bool disabled = false;      // A failed group could not be rolled back
+
+    mutable mutex guard;        // Protects everything above against the flusher thread
+    condition_variable wake;
+    thread flusher;
+    bool stopping = false;
+
+    template <typename T>
+    static void put(vector<char>& out, const T& value) {
+        const char* raw = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), raw, raw + sizeof(T));
+    }
+
+    static void putString(vector<char>& out, const string& value) {
+        put(out, static_cast<uint32_t>(value.size()));
+        out.insert(out.end(), value.begin(), value.end());
+    }
+
+    template <typename T>
+    static bool get(const char*& cursor, const char* end, T& value) {
+        if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    static bool getString(const char*& cursor, const char* end, string& value) {
+        uint32_t length;
+        if (!get(cursor, end, length) || static_cast<size_t>(end - cursor) < length) {
+            return false;
+        }
+        value.assign(cursor, length);
+        cursor += length;
+        return true;
+    }
+
+    // Cut the log back to 'start' bytes after a failed group
+#ifdef _WIN32
+    bool rollBack(uintmax_t start) {
+        file.close();
+        error_code error;
+        filesystem::resize_file(path, start, error);
+        file.clear();
+        file.open(path, ios::binary | ios::app);
+        return !error && file.is_open();
+    }
+#else
+    bool rollBack(off_t start) {
+        if (start < 0) {
+            return false;
+        }
+        while (ftruncate(fd, start) != 0) {
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+#endif
+
+    // Write the staged group (the caller holds 'guard'); see commit()
+    bool commitGroup() {
+        if (pendingRecords == 0) {
+            return true;
+        }
+        if (disabled) {
+            return false;
+        }
+        bool ok = true;
+#ifdef _WIN32
+        error_code sizeError;
+        uintmax_t start = filesystem::file_size(path, sizeError);
+        ok = !sizeError && file.is_open() && file.write(pending.data(), pending.size()) && file.flush();
+#else
+        off_t start = fd >= 0 ? lseek(fd, 0, SEEK_END) : -1;
+        ok = start >= 0;
+        const char* data = pending.data();
+        size_t remaining = pending.size();
+        while (ok && remaining > 0) {
+            ssize_t written = ::write(fd, data, remaining);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            ok = written > 0;
+            if (ok) {
+                data += written;
+                remaining -= static_cast<size_t>(written);
+            }
+        }
+        ok = ok && fsync(fd) == 0;
+#endif
+        if (!ok) {
+            if (rollBack(start)) {
+                cerr << "Error: could not write the write-ahead log " << path << ", " << pendingRecords
+                     << " records kept for the next commit\n";
+                oldestPending = chrono::steady_clock::now(); // The flusher retries after another interval
+            } else {
+                cerr << "Error: could not repair the write-ahead log " << path << ", logging disabled\n";
+                disabled = true;
+            }
+            return false;
+        }
+        ++committedGroups;
+        committedRecords += pendingRecords;
+        pending.clear();
+        pendingRecords = 0;
+        return true;
+    }
+
+    // Frame an encoded payload and stage it, committing the group if it is full or old
+    void stage(const vector<char>& payload) {
+        lock_guard<mutex> lock(guard);
+        if (disabled) {
+            return;
+        }
+        if (pendingRecords == 0) {
+            oldestPending = chrono::steady_clock::now();
+            wake.notify_one(); // Start the flusher's deadline for this group
+        }
+        put(pending, static_cast<uint32_t>(payload.size()));
+        put(pending, fnv1a64(payload.data(), payload.size()));
+        pending.insert(pending.end(), payload.begin(), payload.end());
+        ++pendingRecords;
+        if (pendingRecords >= GROUP_COMMIT_RECORDS ||
+            chrono::steady_clock::now() - oldestPending >= GROUP_COMMIT_INTERVAL) {
+            commitGroup();
+        }
+    }
+
+    // Flusher thread: commit a group once its oldest record is GROUP_COMMIT_INTERVAL
+    // old, even if no further record arrives to trigger the commit
+    void flushIdleGroups() {
+        unique_lock<mutex> lock(guard);
+        while (!stopping) {
+            if (pendingRecords == 0 || disabled) {
+                wake.wait(lock);
+            } else if (wake.wait_until(lock, oldestPending + GROUP_COMMIT_INTERVAL) == cv_status::timeout &&
+                       pendingRecords > 0) {
+                commitGroup();
+            }
+        }
+    }
+
+    static bool decode(const char* cursor, const char* end, WalRecord& record) {
+        uint8_t op;
+        int64_t lastUpdated;
+        if (!get(cursor, end, op) || !get(cursor, end, record.area.id)) {
+            return false;
+        }
+        record.op = static_cast<WalOp>(op);
+        Area& area = record.area;
+        switch (record.op) {
+            case WalOp::Upsert:
+                if (!getString(cursor, end, area.name) || !get(cursor, end, area.wasteQuantity) ||
+                    !getString(cursor, end, area.wasteCategory) || !get(cursor, end, area.areaSize) ||
+                    !getString(cursor, end, area.location) || !get(cursor, end, area.population) ||
+                    !get(cursor, end, lastUpdated) || !getString(cursor, end, area.wasteManagementStrategy) ||
+                    !get(cursor, end, area.environmentalImpactScore) || !get(cursor, end, area.budgetAllocated)) {
+                    return false;
+                }
+                area.lastUpdated = static_cast<time_t>(lastUpdated);
+                if (cursor != end && (!get(cursor, end, area.latitude) || !get(cursor, end, area.longitude))) {
+                    return false; // Coordinates are optional so logs written before they existed still replay
+                }
+                break;
+            case WalOp::Erase:
+                break;
+            case WalOp::Reading:
+                if (!get(cursor, end, area.wasteQuantity) || !get(cursor, end, lastUpdated)) {
+                    return false;
+                }
+                area.lastUpdated = static_cast<time_t>(lastUpdated);
+                break;
+            default:
+                return false;
+        }
+        return cursor == end;
+    }
+
+public:
+
+    AreaWriteAheadLog() = default;
+    AreaWriteAheadLog(const AreaWriteAheadLog&) = delete;
+    AreaWriteAheadLog& operator=(const AreaWriteAheadLog&) = delete;
+
+    ~AreaWriteAheadLog() {
+        close();
+    }
+
+    // Open the log for appending, optionally discarding its contents
+    bool open(const string& filename, bool truncate) {
+        close();
+        lock_guard<mutex> lock(guard);
+        path = filename;
+#ifdef _WIN32
+        file.open(filename, ios::binary | (truncate ? ios::trunc : ios::app));
+        bool opened = file.is_open();
+#else
+        fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0), 0644);
+        bool opened = fd >= 0;
+#endif
+        if (opened) {
+            stopping = false;
+            flusher = thread(&AreaWriteAheadLog::flushIdleGroups, this);
+        }
+        return opened;
+    }
+
+    // Stop the flusher, commit pending records and close the file
+    void close() {
+        if (flusher.joinable()) {
+            {
+                lock_guard<mutex> lock(guard);
+                stopping = true;
+            }
+            wake.notify_all();
+            flusher.join();
+        }
+        lock_guard<mutex> lock(guard);
+        commitGroup();
+#ifdef _WIN32
+        if (file.is_open()) {
+            file.close();
+        }
+#else
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+    }
+
+    // Write and fsync every staged record as one group. If the write or the fsync
+    // fails the log is cut back to where the group started, so no torn frame is left
+    // in front of later groups, and the group stays pending to be retried with the
+    // next commit. If the log cannot be cut back it is disabled
+    bool commit() {
+        lock_guard<mutex> lock(guard);
+        return commitGroup();
+    }
+
+    // True once a failed group could not be rolled back; nothing is logged after that
+    bool isDisabled() const {
+        lock_guard<mutex> lock(guard);
+        return disabled;
+    }
+
+    // Discard the log contents (after its records were compacted into a snapshot)
+    bool reset() {
+        {
+            lock_guard<mutex> lock(guard);
+            pending.clear();
+            pendingRecords = 0;
+            disabled = false;
+        }
+        return open(path, true);
+    }
+
+    void logUpsert(const Area& area) {
+        vector<char> payload;
+        put(payload, static_cast<uint8_t>(WalOp::Upsert));
+        put(payload, area.id);
+        putString(payload, area.name);
+        put(payload, area.wasteQuantity);
+        putString(payload, area.wasteCategory);
+        put(payload, area.areaSize);
+        putString(payload, area.location);
+        put(payload, area.population);
+        put(payload, static_cast<int64_t>(area.lastUpdated));
+        putString(payload, area.wasteManagementStrategy);
+        put(payload, area.environmentalImpactScore);
+        put(payload, area.budgetAllocated);
+        put(payload, area.latitude);
+        put(payload, area.longitude);
+        stage(payload);
+    }
+
+    void logErase(int id) {
+        vector<char> payload;
+        put(payload, static_cast<uint8_t>(WalOp::Erase));
+        put(payload, id);
+        stage(payload);
+    }
+
+    void logReading(int id, double wasteQuantity, time_t timestamp) {
+        vector<char> payload;
+        put(payload, static_cast<uint8_t>(WalOp::Reading));
+        put(payload, id);
+        put(payload, wasteQuantity);
+        put(payload, static_cast<int64_t>(timestamp));
+        stage(payload);
+    }
+
+    size_t groupCount() const {
+        lock_guard<mutex> lock(guard);
+        return committedGroups;
+    }
+
+    size_t recordCount() const {
+        lock_guard<mutex> lock(guard);
+        return committedRecords;
+    }
+
+    // Decode every intact record of a log file. Returns the byte length of the valid
+    // prefix so a torn tail left by a crash can be cut off
+    static size_t replay(const string& filename, const function<void(const WalRecord&)>& apply) {
+        MappedFile file;
+        if (!file.open(filename)) {
+            return 0;
+        }
+        const char* begin = file.data();
+        const char* cursor = begin;
+        const char* end = begin + file.size();
+        WalRecord record;
+        while (true) {
+            const char* frame = cursor;
+            uint32_t length;
+            uint64_t checksum;
+            if (!get(cursor, end, length) || !get(cursor, end, checksum) ||
+                static_cast<size_t>(end - cursor) < length ||
+                fnv1a64(cursor, length) != checksum || !decode(cursor, cursor + length, record)) {
+                return static_cast<size_t>(frame - begin);
+            }
+            cursor += length;
+            apply(record);
+        }
+    }
+};
+
+// Immutable slice of the registry published for concurrent readers
+struct AreaShard {
+    vector<Area> areas; // Sorted by ID
+    double budget = 0;
+    double waste = 0;
+    long long population = 0;
+
+    // Recompute the aggregates after the areas changed
+    void summarize() {
+        RunningSum budgetSum, wasteSum;
+        population = 0;
+        for (const Area& area : areas) {
+            budgetSum.add(area.budgetAllocated);
+            wasteSum.add(area.wasteQuantity);
+            population += area.population;
+        }
+        budget = budgetSum.value();
+        waste = wasteSum.value();
+    }
+};
+
+// Consistent, read-only view of the whole registry at one version. Every query
+// answered from the same RegistrySnapshot sees the same state, whatever the
+// writer does meanwhile
+class RegistrySnapshot {
+
+private:
+
+    vector<shared_ptr<const AreaShard>> shards;
+    uint64_t versionNumber = 0;
+
+    friend class ConcurrentAreaRegistry;
+
+public:
+
+    uint64_t version() const {
+        return versionNumber;
+    }
+
+    size_t areaCount() const {
+        size_t count = 0;
+        for (const auto& shard : shards) {
+            count += shard->areas.size();
+        }
+        return count;
+    }
+
+    double totalBudget() const {
+        double total = 0;
+        for (const auto& shard : shards) {
+            total += shard->budget;
+        }
+        return total;
+    }
+
+    double totalWaste() const {
+        double total = 0;
+        for (const auto& shard : shards) {
+            total += shard->waste;
+        }
+        return total;
+    }
+
+    long long totalPopulation() const {
+        long long total = 0;
+        for (const auto& shard : shards) {
+            total += shard->population;
+        }
+        return total;
+    }
+
+    // Call 'visit' for every area, shard by shard
+    template <typename Visit>
+    void forEach(const Visit& visit) const {
+        for (const auto& shard : shards) {
+            for (const Area& area : shard->areas) {
+                visit(area);
+            }
+        }
+    }
+
+    // Area with the given ID, or nullptr; valid while the snapshot is held
+    const Area* find(int id) const;
+
+    // Areas of a waste category, in ascending ID order
+    vector<Area> areasByCategory(const string& category) const {
+        vector<Area> result;
+        forEach([&](const Area& area) {
+            if (area.wasteCategory == category) {
+                result.push_back(area);
+            }
+        });
+        sort(result.begin(), result.end(), [](const Area& a, const Area& b) { return a.id < b.id; });
+        return result;
+    }
+
+    // Method to display the areas of the snapshot in ascending ID order
+    void displayAreas(size_t maxRows) const {
+        vector<const Area*> sorted;
+        forEach([&](const Area& area) { sorted.push_back(&area); });
+        sort(sorted.begin(), sorted.end(), [](const Area* a, const Area* b) { return a->id < b->id; });
+        cout << "\nRegistry version " << versionNumber << ": " << sorted.size() << " areas\n";
+        ReportTable table({"AID", "Area Name", "Waste (t)", "Waste Cat", "Budget Alloc"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::RIGHT, ReportTable::LEFT,
+                           ReportTable::RIGHT});
+        for (size_t i = 0; i < sorted.size() && i < maxRows; ++i) {
+            table.cell(sorted[i]->id).cell(sorted[i]->name).cell(sorted[i]->wasteQuantity)
+                 .cell(sorted[i]->wasteCategory).cell(sorted[i]->budgetAllocated);
+        }
+        table.render(cout);
+    }
+};
+
+// Read-copy-update publication of the area registry
+//
+// Areas are split into SHARD_COUNT shards by ID. One writer stages changes: the
+// first change to a shard copies it, later changes edit the copy. publish()
+// builds a new root that shares every untouched shard with the previous one and
+// swaps it in with a single atomic pointer store. Readers atomically load the
+// root and keep it alive through the shared_ptr, so they never wait for the
+// writer and never see a half-applied batch; an old version is freed when its
+// last reader drops it
+class ConcurrentAreaRegistry {
+
+public:
+
+    static const size_t SHARD_COUNT = 64;
+
+private:
+
+    // Writer-side copy of a shard changed since publish(). The first 'sorted' areas
+    // are the shard as published, in ID order; new areas are appended after them
+    // and sorted in once per batch by settle()
+    struct StagedShard {
+        shared_ptr<AreaShard> shard;
+        size_t sorted;
+    };
+
+    shared_ptr<const RegistrySnapshot> root;       // Accessed only through atomic_load/atomic_store
+    unordered_map<size_t, StagedShard> staged;     // Shards changed since publish()
+
+    static size_t shardOf(int id) {
+        return static_cast<uint32_t>(id) % SHARD_COUNT;
+    }
+
+    static bool byId(const Area& area, int id) {
+        return area.id < id;
+    }
+
+    // Writable copy of a shard, made on its first change since the last publish.
+    // The copy duplicates every Area of the shard, strings included, so a publish
+    // costs about (shards touched / SHARD_COUNT) of the registry no matter how few
+    // rows changed: a single-area update copies one shard, a batch touching every
+    // shard copies the whole registry once
+    StagedShard& stage(int id) {
+        size_t shard = shardOf(id);
+        auto it = staged.find(shard);
+        if (it == staged.end()) {
+            auto copy = make_shared<AreaShard>(*snapshot()->shards[shard]);
+            size_t sorted = copy->areas.size();
+            it = staged.emplace(shard, StagedShard{std::move(copy), sorted}).first;
+        }
+        return it->second;
+    }
+
+    // Sort the appended areas into the shard, keeping the last upsert of each ID.
+    // The appended IDs are never in the sorted part, so one merge restores ID order
+    static void settle(StagedShard& staging) {
+        vector<Area>& areas = staging.shard->areas;
+        if (staging.sorted == areas.size()) {
+            return;
+        }
+        auto added = areas.begin() + staging.sorted;
+        stable_sort(added, areas.end(), [](const Area& a, const Area& b) { return a.id < b.id; });
+        auto kept = added;
+        for (auto it = added; it != areas.end(); ++it) {
+            if (it + 1 != areas.end() && (it + 1)->id == it->id) {
+                continue; // A later upsert of the same ID replaces this one
+            }
+            if (kept != it) {
+                *kept = std::move(*it);
+            }
+            ++kept;
+        }
+        areas.erase(kept, areas.end());
+        inplace_merge(areas.begin(), areas.begin() + staging.sorted, areas.end(),
+                      [](const Area& a, const Area& b) { return a.id < b.id; });
+        staging.sorted = areas.size();
+    }
+
+public:
+
+    ConcurrentAreaRegistry() {
+        auto empty = make_shared<RegistrySnapshot>();
+        auto shard = make_shared<const AreaShard>();
+        empty->shards.assign(SHARD_COUNT, shard);
+        root = empty;
+    }
+
+    // Current version; safe to call from any thread
+    shared_ptr<const RegistrySnapshot> snapshot() const {
+        return atomic_load(&root);
+    }
+
+    // Writer: insert or replace an area. A new area is appended and sorted in at
+    // publish(), so a batch of inserts costs one sort rather than a shift each
+    void upsert(const Area& area) {
+        StagedShard& staging = stage(area.id);
+        vector<Area>& areas = staging.shard->areas;
+        auto sortedEnd = areas.begin() + staging.sorted;
+        auto it = lower_bound(areas.begin(), sortedEnd, area.id, byId);
+        if (it != sortedEnd && it->id == area.id) {
+            *it = area;
+        } else {
+            areas.push_back(area);
+        }
+    }
+
+    // Writer: remove an area
+    void erase(int id) {
+        StagedShard& staging = stage(id);
+        settle(staging);
+        vector<Area>& areas = staging.shard->areas;
+        auto it = lower_bound(areas.begin(), areas.end(), id, byId);
+        if (it != areas.end() && it->id == id) {
+            areas.erase(it);
+            staging.sorted = areas.size();
+        }
+    }
+
+    // Writer: replace every area, e.g. after a snapshot or CSV load
+    void reset(const AreaColumns& columns) {
+        vector<shared_ptr<AreaShard>> shards(SHARD_COUNT);
+        for (auto& shard : shards) {
+            shard = make_shared<AreaShard>();
+        }
+        for (size_t row = 0; row < columns.size(); ++row) {
+            shards[shardOf(columns.id[row])]->areas.push_back(columns.row(row));
+        }
+        staged.clear();
+        for (size_t i = 0; i < SHARD_COUNT; ++i) {
+            sort(shards[i]->areas.begin(), shards[i]->areas.end(),
+                 [](const Area& a, const Area& b) { return a.id < b.id; });
+            size_t sorted = shards[i]->areas.size();
+            staged.emplace(i, StagedShard{shards[i], sorted});
+        }
+        publish();
+    }
+
+    // Writer: make the staged changes visible to readers as one new version
+    void publish() {
+        if (staged.empty()) {
+            return;
+        }
+        shared_ptr<const RegistrySnapshot> current = snapshot();
+        auto next = make_shared<RegistrySnapshot>(*current); // Copies only the shard pointers
+        for (auto& entry : staged) {
+            settle(entry.second);
+            entry.second.shard->summarize();
+            next->shards[entry.first] = std::move(entry.second.shard);
+        }
+        next->versionNumber = current->versionNumber + 1;
+        staged.clear();
+        atomic_store(&root, shared_ptr<const RegistrySnapshot>(std::move(next)));
+    }
+};
+
+inline const Area* RegistrySnapshot::find(int id) const {
+    const vector<Area>& areas = shards[static_cast<uint32_t>(id) % ConcurrentAreaRegistry::SHARD_COUNT]->areas;
+    auto it = lower_bound(areas.begin(), areas.end(), id, [](const Area& area, int key) { return area.id < key; });
+    return it != areas.end() && it->id == id ? &*it : nullptr;
+}
+
+// Persistent (immutable, structurally shared) map from area ID to area record
+//
+// A hash array mapped trie: each node has a 32-bit bitmap and one entry per set
+// bit, either an area or a child node for the next 5 bits of the key. Changing an
+// area copies only the nodes on its path, so an old copy of the map stays valid
+// and shares every untouched node with the new one. Nodes created under the
+// current edit ID are not yet shared and are changed in place, which makes a batch
+// of changes cheap. The key is a bijective mix of the ID, so keys never collide
+class PersistentAreaMap {
+
+private:
+
+    struct Node;
+    using NodePtr = shared_ptr<Node>;
+
+    struct Entry {
+        NodePtr child;               // Set for a subtree
+        shared_ptr<const Area> area; // Set for a leaf
+    };
+
+    struct Node {
+        uint32_t bitmap = 0;
+        uint64_t edit = 0;   // Edit ID that created the node
+        vector<Entry> entries;
+    };
+
+    static const int BITS = 5;
+
+    NodePtr root;
+    size_t count = 0;
+
+    static uint32_t keyOf(int id) {
+        uint32_t x = static_cast<uint32_t>(id);
+        x ^= x >> 16;
+        x *= 0x7feb352dU;
+        x ^= x >> 15;
+        x *= 0x846ca68bU;
+        x ^= x >> 16;
+        return x;
+    }
+
+    static size_t slotOf(const Node& node, uint32_t bit) {
+        return bitset<32>(node.bitmap & (bit - 1)).count();
+    }
+
+    // The node itself if it belongs to this edit, otherwise a copy that does
+    static NodePtr writable(const NodePtr& node, uint64_t edit) {
+        if (node && node->edit == edit) {
+            return node;
+        }
+        NodePtr copy = node ? make_shared<Node>(*node) : make_shared<Node>();
+        copy->edit = edit;
+        return copy;
+    }
+
+    static NodePtr set(const NodePtr& node, uint32_t key, const shared_ptr<const Area>& area, int shift,
+                       uint64_t edit, bool& added) {
+        NodePtr n = writable(node, edit);
+        uint32_t bit = 1u << ((key >> shift) & 31);
+        size_t slot = slotOf(*n, bit);
+        if ((n->bitmap & bit) == 0) {
+            n->entries.insert(n->entries.begin() + slot, Entry{nullptr, area});
+            n->bitmap |= bit;
+            added = true;
+            return n;
+        }
+        Entry& entry = n->entries[slot];
+        if (entry.child) {
+            entry.child = set(entry.child, key, area, shift + BITS, edit, added);
+        } else if (keyOf(entry.area->id) == key) {
+            entry.area = area;
+        } else {
+            // Two keys share this prefix: push the existing leaf one level down
+            bool ignored = false;
+            NodePtr child = set(nullptr, keyOf(entry.area->id), entry.area, shift + BITS, edit, ignored);
+            entry.child = set(child, key, area, shift + BITS, edit, added);
+            entry.area = nullptr;
+        }
+        return n;
+    }
+
+    // Returns the new node, nullptr if it became empty
+    static NodePtr erase(const NodePtr& node, uint32_t key, int shift, uint64_t edit, bool& removed) {
+        uint32_t bit = 1u << ((key >> shift) & 31);
+        if ((node->bitmap & bit) == 0) {
+            return node;
+        }
+        size_t slot = slotOf(*node, bit);
+        const Entry& entry = node->entries[slot];
+        NodePtr child;
+        if (entry.child) {
+            child = erase(entry.child, key, shift + BITS, edit, removed);
+        } else {
+            removed = keyOf(entry.area->id) == key;
+        }
+        if (!removed) {
+            return node;
+        }
+
+        NodePtr n = writable(node, edit);
+        if (child && child->entries.size() == 1 && !child->entries[0].child) {
+            n->entries[slot] = child->entries[0]; // Pull a lone leaf up so the shape stays canonical
+        } else if (child) {
+            n->entries[slot].child = child;
+        } else {
+            n->entries.erase(n->entries.begin() + slot);
+            n->bitmap &= ~bit;
+        }
+        return n->entries.empty() ? nullptr : n;
+    }
+
+    template <typename Visit>
+    static void forEachIn(const Entry& entry, const Visit& visit) {
+        if (entry.area) {
+            visit(entry.area);
+            return;
+        }
+        for (const Entry& child : entry.child->entries) {
+            forEachIn(child, visit);
+        }
+    }
+
+    // Report every area that differs between two entries at the same trie position
+    template <typename Report>
+    static void diffEntries(const Entry* before, const Entry* after, const Report& report) {
+        if (before && after && before->child && after->child) {
+            diffNodes(before->child.get(), after->child.get(), report);
+            return;
+        }
+        if (before && after && before->area && after->area && before->area->id == after->area->id) {
+            if (before->area != after->area) {
+                report(before->area, after->area);
+            }
+            return;
+        }
+        // Leaf against subtree (or a missing side): compare their areas by ID
+        unordered_map<int, shared_ptr<const Area>> old;
+        if (before) {
+            forEachIn(*before, [&](const shared_ptr<const Area>& area) { old[area->id] = area; });
+        }
+        if (after) {
+            forEachIn(*after, [&](const shared_ptr<const Area>& area) {
+                auto it = old.find(area->id);
+                if (it == old.end()) {
+                    report(nullptr, area);
+                } else {
+                    if (it->second != area) {
+                        report(it->second, area);
+                    }
+                    old.erase(it);
+                }
+            });
+        }
+        for (const auto& entry : old) {
+            report(entry.second, nullptr);
+        }
+    }
+
+    template <typename Report>
+    static void diffNodes(const Node* before, const Node* after, const Report& report) {
+        if (before == after) {
+            return; // Shared subtree: nothing below it changed
+        }
+        uint32_t beforeBits = before ? before->bitmap : 0, afterBits = after ? after->bitmap : 0;
+        for (uint32_t bits = beforeBits | afterBits; bits != 0; bits &= bits - 1) {
+            uint32_t bit = bits & (~bits + 1);
+            const Entry* b = (beforeBits & bit) ? &before->entries[slotOf(*before, bit)] : nullptr;
+            const Entry* a = (afterBits & bit) ? &after->entries[slotOf(*after, bit)] : nullptr;
+            if (b && a && b->child == a->child && b->area == a->area) {
+                continue;
+            }
+            diffEntries(b, a, report);
+        }
+    }
+
+public:
+
+    size_t size() const {
+        return count;
+    }
+
+    // Insert or replace an area; 'edit' identifies the batch of changes being made
+    void set(const Area& area, uint64_t edit) {
+        bool added = false;
+        root = set(root, keyOf(area.id), make_shared<const Area>(area), 0, edit, added);
+        count += added;
+    }
+
+    void erase(int id, uint64_t edit) {
+        if (!root) {
+            return;
+        }
+        bool removed = false;
+        root = erase(root, keyOf(id), 0, edit, removed);
+        count -= removed;
+    }
+
+    // Area with the given ID, or nullptr
+    shared_ptr<const Area> find(int id) const {
+        uint32_t key = keyOf(id);
+        const Node* node = root.get();
+        for (int shift = 0; node != nullptr; shift += BITS) {
+            uint32_t bit = 1u << ((key >> shift) & 31);
+            if ((node->bitmap & bit) == 0) {
+                return nullptr;
+            }
+            const Entry& entry = node->entries[slotOf(*node, bit)];
+            if (!entry.child) {
+                return entry.area->id == id ? entry.area : nullptr;
+            }
+            node = entry.child.get();
+        }
+        return nullptr;
+    }
+
+    template <typename Visit>
+    void forEach(const Visit& visit) const {
+        if (!root) {
+            return;
+        }
+        for (const Entry& entry : root->entries) {
+            forEachIn(entry, visit);
+        }
+    }
+
+    // Call report(before, after) for every area that differs between two maps;
+    // 'before' is null for added areas and 'after' for removed ones. Subtrees the
+    // maps share are skipped, so the cost follows the number of changes
+    template <typename Report>
+    static void diff(const PersistentAreaMap& before, const PersistentAreaMap& after, const Report& report) {
+        diffNodes(before.root.get(), after.root.get(), report);
+    }
+};
+
+// One version of the registry
+struct RegistryVersion {
+    uint64_t number;
+    time_t time;
+    string change;          // What produced this version
+    PersistentAreaMap areas;
+};
+
+// Change of one area between two versions (null 'before' = added, null 'after' = removed)
+struct AreaChange {
+    shared_ptr<const Area> before;
+    shared_ptr<const Area> after;
+};
+
+// History of the versions of the registry. Changes are applied to a working map
+// and commit() freezes it as a new version that shares all untouched nodes with
+// the previous one. Only the newest versions are kept: once there are more than
+// 'maxVersions' or the oldest is more than 'maxAge' seconds older than the newest,
+// the oldest are dropped and the nodes only they used are freed (0 = no limit)
+class VersionedAreaHistory {
+
+private:
+
+    deque<RegistryVersion> history;
+    PersistentAreaMap working;
+    uint64_t edit = 1;
+    uint64_t nextNumber = 1;
+    size_t maxVersions;
+    time_t maxAge;
+    bool dirty = false;
+
+    // Drop the oldest versions beyond the retention limits, always keeping the newest
+    void prune() {
+        while (history.size() > 1 && ((maxVersions > 0 && history.size() > maxVersions) ||
+                                      (maxAge > 0 && history.back().time - history.front().time > maxAge))) {
+            history.pop_front();
+        }
+    }
+
+public:
+
+    explicit VersionedAreaHistory(size_t maxVersions = 0, time_t maxAge = 0)
+        : maxVersions(maxVersions), maxAge(maxAge) {}
+
+    void set(const Area& area) {
+        working.set(area, edit);
+        dirty = true;
+    }
+
+    void erase(int id) {
+        working.erase(id, edit);
+        dirty = true;
+    }
+
+    // Start the working map over from the given areas
+    void replaceAll(const AreaColumns& columns) {
+        working = PersistentAreaMap();
+        ++edit;
+        for (size_t row = 0; row < columns.size(); ++row) {
+            working.set(columns.row(row), edit);
+        }
+        dirty = true;
+    }
+
+    // Freeze the pending changes as a new version
+    void commit(time_t when, const string& change) {
+        if (!dirty) {
+            return;
+        }
+        if (!history.empty()) {
+            when = max(when, history.back().time); // Keep versions ordered by time
+        }
+        history.push_back({nextNumber++, when, change, working});
+        ++edit; // Nodes of the committed version must not be changed in place any more
+        dirty = false;
+        prune();
+    }
+
+    // Kept versions, oldest first
+    const deque<RegistryVersion>& versions() const {
+        return history;
+    }
+
+    // Version by number, or nullptr if it was never committed or has been dropped
+    const RegistryVersion* version(uint64_t number) const {
+        if (history.empty() || number < history.front().number) {
+            return nullptr;
+        }
+        uint64_t offset = number - history.front().number;
+        return offset < history.size() ? &history[offset] : nullptr;
+    }
+
+    // Latest version committed at or before 'when', or nullptr
+    const RegistryVersion* at(time_t when) const {
+        auto it = upper_bound(history.begin(), history.end(), when,
+                              [](time_t t, const RegistryVersion& v) { return t < v.time; });
+        return it == history.begin() ? nullptr : &*(it - 1);
+    }
+
+    // Areas that differ between two versions, in ascending ID order
+    static vector<AreaChange> diff(const RegistryVersion& before, const RegistryVersion& after) {
+        vector<AreaChange> changes;
+        PersistentAreaMap::diff(before.areas, after.areas,
+                                [&](const shared_ptr<const Area>& b, const shared_ptr<const Area>& a) {
+            changes.push_back({b, a});
+        });
+        sort(changes.begin(), changes.end(), [](const AreaChange& x, const AreaChange& y) {
+            return (x.after ? x.after->id : x.before->id) < (y.after ? y.after->id : y.before->id);
+        });
+        return changes;
+    }
+};
+
+const size_t VERSION_HISTORY_LIMIT = 1000;             // Registry versions kept by area management
+const time_t VERSION_HISTORY_MAX_AGE = 30 * 24 * 3600; // Oldest kept version, in seconds before the newest
+
+// Graph class to represent a weighted graph of areas
+class Graph {
+
+private:
+
+    AreaColumns columns; // Column arrays holding the data of every area
+
+    unordered_map<int, size_t> rowOf; // Hashmap from area ID to its row in the columns
+
+    SecondaryIndex<Symbol> categoryIndex; // Waste category -> area IDs
+    SecondaryIndex<Symbol> strategyIndex; // Waste management strategy -> area IDs
+    SecondaryIndex<Symbol> locationIndex; // Location -> area IDs
+
+    // Area IDs holding 'value' in a symbol index; a value that was never interned matches nothing
+    const unordered_set<int>* findSymbol(const SecondaryIndex<Symbol>& index, const string& value) const {
+        Symbol symbol;
+        if (!columns.symbols->find(value, symbol)) {
+            return nullptr;
+        }
+        return index.find(symbol);
+    }
+
+    // Ordered indexes on numeric fields; waste quantity is always indexed, the
+    // others are built the first time a query asks for them
+    mutable array<unique_ptr<OrderedIndex>, AREA_FIELD_COUNT> orderedIndexes;
+
+    // Registry-wide aggregates, updated on every mutation
+    RunningSum totalBudget;
+    RunningSum totalWaste;
+    long long totalPopulation = 0;
+    OrderedIndex impactIndex; // calculateEnvironmentalImpact() -> area ID
+    unordered_map<Symbol, OrderedIndex> densityByCategory; // Waste category -> (waste density -> area ID)
+    GeoGridIndex geoIndex; // Coordinates of the areas that have them
+
+#ifdef WMS_DEBUG_AGGREGATES
+    bool checkAggregatesOnRead = true;
+#else
+    bool checkAggregatesOnRead = false;
+#endif
+
+    // Environmental impact of a row, same formula as Area::calculateEnvironmentalImpact
+    double rowImpact(size_t row) const {
+        return columns.environmentalImpactScore[row] * (columns.wasteQuantity[row] / 1000);
+    }
+
+    // Waste density of a row, same formula as Area::calculateWasteDensity
+    double rowDensity(size_t row) const {
+        return columns.areaSize[row] > 0 ? columns.wasteQuantity[row] / columns.areaSize[row] : 0;
+    }
+
+    // In debug mode, cross-check the running aggregates against a full recompute
+    void debugCheckAggregates() const {
+        if (checkAggregatesOnRead && !verifyAggregates()) {
+            cerr << "Warning: incremental aggregates differ from a full recompute!\n";
+        }
+    }
+
+    // Value of a numeric field in a row
+    double fieldValue(size_t row, AreaField field) const {
+        switch (field) {
+            case AreaField::WasteQuantity: return columns.wasteQuantity[row];
+            case AreaField::AreaSize: return columns.areaSize[row];
+            case AreaField::Population: return columns.population[row];
+            case AreaField::EnvironmentalImpactScore: return columns.environmentalImpactScore[row];
+            case AreaField::BudgetAllocated: return columns.budgetAllocated[row];
+            case AreaField::LastUpdated: return static_cast<double>(columns.lastUpdated[row]);
+        }
+        return 0;
+    }
+
+    // Add a row to the indexes and aggregates
+    void indexRow(size_t row) {
+        int id = columns.id[row];
+        totalBudget.add(columns.budgetAllocated[row]);
+        totalWaste.add(columns.wasteQuantity[row]);
+        totalPopulation += columns.population[row];
+        impactIndex.add(rowImpact(row), id);
+        densityByCategory[columns.wasteCategory[row]].add(rowDensity(row), id);
+        if (!std::isnan(columns.latitude[row]) && !std::isnan(columns.longitude[row])) {
+            geoIndex.add(id, columns.latitude[row], columns.longitude[row]);
+        }
+        categoryIndex.add(columns.wasteCategory[row], id);
+        strategyIndex.add(columns.wasteManagementStrategy[row], id);
+        locationIndex.add(columns.location[row], id);
+        for (size_t f = 0; f < AREA_FIELD_COUNT; ++f) {
+            if (orderedIndexes[f]) {
+                orderedIndexes[f]->add(fieldValue(row, AreaField(f)), id);
+            }
+        }
+    }
+
+    // Remove a row from the indexes and aggregates
+    void unindexRow(size_t row) {
+        int id = columns.id[row];
+        totalBudget.subtract(columns.budgetAllocated[row]);
+        totalWaste.subtract(columns.wasteQuantity[row]);
+        totalPopulation -= columns.population[row];
+        impactIndex.remove(rowImpact(row), id);
+        auto density = densityByCategory.find(columns.wasteCategory[row]);
+        density->second.remove(rowDensity(row), id);
+        if (density->second.size() == 0) {
+            densityByCategory.erase(density);
+        }
+        geoIndex.remove(id);
+        categoryIndex.remove(columns.wasteCategory[row], id);
+        strategyIndex.remove(columns.wasteManagementStrategy[row], id);
+        locationIndex.remove(columns.location[row], id);
+        for (size_t f = 0; f < AREA_FIELD_COUNT; ++f) {
+            if (orderedIndexes[f]) {
+                orderedIndexes[f]->remove(fieldValue(row, AreaField(f)), id);
+            }
+        }
+    }
+
+    // Insert a new area row, or overwrite the row if the ID already exists
+    void insertRow(const Area& area) {
+        auto it = rowOf.find(area.id);
+        if (it != rowOf.end()) {
+            updateRow(it->second, area);
+            return;
+        }
+        rowOf[area.id] = columns.size();
+        columns.append(area);
+        indexRow(columns.size() - 1);
+        wasteHistory.append(area.id, area.lastUpdated, area.wasteQuantity);
+        anomalyDetector.track(area.id, area.wasteQuantity, area.lastUpdated);
+        publishRow(columns.size() - 1);
+        if (history) {
+            history->set(area);
+        }
+        if (wal) {
+            wal->logUpsert(area);
+            ++loggedSinceCheckpoint;
+        }
+    }
+
+    // Overwrite the data of an existing row
+    void updateRow(size_t row, const Area& area) {
+        if (area.wasteQuantity != columns.wasteQuantity[row]) {
+            // A manual correction is not a sensor reading: restart the area's statistics
+            anomalyDetector.track(area.id, area.wasteQuantity, area.lastUpdated);
+        }
+        unindexRow(row);
+        columns.assign(row, area);
+        indexRow(row);
+        wasteHistory.append(area.id, area.lastUpdated, area.wasteQuantity);
+        publishRow(row);
+        if (history) {
+            history->set(area);
+        }
+        if (wal) {
+            wal->logUpsert(area);
+            ++loggedSinceCheckpoint;
+        }
+    }
+
+    // Remove a row and fix the index of the row that was moved into its place
+    void eraseRow(size_t row) {
+        unindexRow(row);
+        wasteHistory.erase(columns.id[row]);
+        anomalyDetector.forget(columns.id[row]);
+        if (published) {
+            published->erase(columns.id[row]);
+        }
+        if (history) {
+            history->erase(columns.id[row]);
+        }
+        if (wal) {
+            wal->logErase(columns.id[row]);
+            ++loggedSinceCheckpoint;
+        }
+        rowOf.erase(columns.id[row]);
+        columns.swapRemove(row);
+        if (row < columns.size()) {
+            rowOf[columns.id[row]] = row;
+        }
+    }
+
+    IngestStats ingestTotals; // Counters accumulated over every ingest batch
+
+    WasteTimeSeries wasteHistory; // Every waste quantity reading, per area
+
+    // Spike/drop/staleness detection over the incoming readings
+    WasteAnomalyDetector anomalyDetector;
+    deque<WasteAlert> alertLog; // Most recent alerts, oldest first
+    static const size_t MAX_ALERTS = 10000;
+
+    void recordAlerts(const vector<WasteAlert>& alerts) {
+        for (const WasteAlert& alert : alerts) {
+            alertLog.push_back(alert);
+            if (alertLog.size() > MAX_ALERTS) {
+                alertLog.pop_front();
+            }
+        }
+    }
+
+    // Durable storage: every mutation is appended to the write-ahead log and the
+    // log is periodically compacted into the checkpoint snapshot
+    unique_ptr<AreaWriteAheadLog> wal;
+
+    // Snapshots published for concurrent readers, if enabled
+    unique_ptr<ConcurrentAreaRegistry> published;
+
+    // Stage the current contents of a row for the next published snapshot
+    void publishRow(size_t row) {
+        if (published) {
+            published->upsert(columns.row(row));
+        }
+    }
+    // Every committed version of the registry, if enabled
+    unique_ptr<VersionedAreaHistory> history;
+
+    string checkpointPath;
+    size_t checkpointInterval = 100000; // Logged records between automatic checkpoints
+    size_t loggedSinceCheckpoint = 0;
+
+    // Finish a public mutation: record it as a new version described by 'change',
+    // commit the log group now if 'durableNow', and compact the log once enough
+    // records have accumulated
+    void endMutation(bool durableNow, const string& change) {
+        if (published) {
+            published->publish();
+        }
+        if (history) {
+            history->commit(time(0), change);
+        }
+        if (!wal) {
+            return;
+        }
+        if (durableNow) {
+            wal->commit();
+        }
+        if (wal->isDisabled()) {
+            // The log could not be repaired after a failed write: a checkpoint captures
+            // every change and starts a fresh log, otherwise durability is switched off
+            if (!checkpoint()) {
+                cout << "Error: the write-ahead log failed, durable storage has been turned off.\n";
+                wal.reset();
+            }
+            return;
+        }
+        if (loggedSinceCheckpoint >= checkpointInterval) {
+            checkpoint();
+        }
+    }
+
+    // Record a new waste quantity reading for a row
+    void applyReading(size_t row, double wasteQuantity, time_t timestamp) {
+        unindexRow(row);
+        columns.wasteQuantity[row] = wasteQuantity;
+        columns.lastUpdated[row] = timestamp;
+        indexRow(row);
+        publishRow(row);
+        if (history) {
+            history->set(columns.row(row));
+        }
+    }
+
+    // Append a sensor reading to the write-ahead log
+    void logReading(int id, double wasteQuantity, time_t timestamp) {
+        if (wal) {
+            wal->logReading(id, wasteQuantity, timestamp);
+            ++loggedSinceCheckpoint;
+        }
+    }
+
+    // Apply a logged sensor reading the way ingestReadings did: it joins the area's
+    // time series and becomes the current value unless it is older than the last update
+    void replayReading(size_t row, double wasteQuantity, time_t timestamp) {
+        vector<WasteAlert> alerts;
+        if (wasteHistory.append(columns.id[row], timestamp, wasteQuantity)) {
+            anomalyDetector.observe(columns.id[row], wasteQuantity, timestamp, alerts);
+        }
+        recordAlerts(alerts);
+        if (timestamp >= columns.lastUpdated[row]) {
+            applyReading(row, wasteQuantity, timestamp);
+        }
+    }
+
+    // Rebuild every index after the columns were replaced wholesale
+    void rebuildIndex() {
+        rowOf.clear();
+        rowOf.reserve(columns.size());
+        categoryIndex.clear();
+        strategyIndex.clear();
+        locationIndex.clear();
+        totalBudget = RunningSum();
+        totalWaste = RunningSum();
+        totalPopulation = 0;
+        impactIndex.clear();
+        densityByCategory.clear();
+        geoIndex.clear();
+        wasteHistory.clear();
+        anomalyDetector.clear();
+        for (auto& index : orderedIndexes) {
+            if (index) {
+                index->clear();
+            }
+        }
+        for (size_t row = 0; row < columns.size(); ++row) {
+            rowOf[columns.id[row]] = row;
+            indexRow(row);
+            wasteHistory.append(columns.id[row], columns.lastUpdated[row], columns.wasteQuantity[row]);
+            anomalyDetector.track(columns.id[row], columns.wasteQuantity[row], columns.lastUpdated[row]);
+        }
+        if (published) {
+            published->reset(columns);
+        }
+        if (history) {
+            history->replaceAll(columns);
+        }
+    }
+
+    // Table with the columns shared by every area report
+    static ReportTable areaTable() {
+        return ReportTable({"AID", "Area Name", "Waste (t)", "Waste Cat", "Size (sq.km)", "Location", "Population",
+                            "Strategy", "Environ Impact", "Budget Alloc", "Last Updated"},
+                           {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::RIGHT, ReportTable::LEFT,
+                            ReportTable::RIGHT, ReportTable::LEFT, ReportTable::RIGHT, ReportTable::LEFT,
+                            ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::LEFT});
+    }
+
+    // Add one row of the columns to an area report, resolving symbols only here
+    void addAreaRow(ReportTable& table, size_t row) const {
+        const SymbolTable& symbols = *columns.symbols;
+        table.cell(columns.id[row])
+             .cell(columns.name[row])
+             .cell(columns.wasteQuantity[row])
+             .cell(symbols.name(columns.wasteCategory[row]))
+             .cell(columns.areaSize[row])
+             .cell(symbols.name(columns.location[row]))
+             .cell(columns.population[row])
+             .cell(symbols.name(columns.wasteManagementStrategy[row]))
+             .cell(columns.environmentalImpactScore[row])
+             .cell(columns.budgetAllocated[row])
+             .cell(formatTimestamp(columns.lastUpdated[row]));
+    }
+
+    // Display the areas whose IDs are in 'ids', in the given order
+    void displayAreaIds(const vector<int>& ids) const {
+        if (ids.empty()) {
+            cout << "No matching areas.\n";
+            return;
+        }
+        ReportTable table = areaTable();
+        for (int id : ids) {
+            addAreaRow(table, rowOf.at(id));
+        }
+        table.render(cout);
+    }
+
+    // Display (distance, area ID) pairs with the distance and coordinates of each area
+    void displayAreaDistances(const vector<pair<double, int>>& areas) const {
+        if (areas.empty()) {
+            cout << "No matching areas.\n";
+            return;
+        }
+        ReportTable table({"AID", "Area Name", "Distance (km)", "Latitude", "Longitude", "Waste (t)", "Waste Cat"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::RIGHT, ReportTable::RIGHT,
+                           ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::LEFT});
+        for (const auto& area : areas) {
+            size_t row = rowOf.at(area.second);
+            table.cell(columns.id[row])
+                 .cell(columns.name[row])
+                 .cell(round(area.first * 1000) / 1000)
+                 .cell(columns.latitude[row])
+                 .cell(columns.longitude[row])
+                 .cell(columns.wasteQuantity[row])
+                 .cell(columns.symbols->name(columns.wasteCategory[row]));
+        }
+        table.render(cout);
+    }
+
+    // Display the areas whose IDs are in 'ids', in ascending ID order
+    void displayAreaIds(const unordered_set<int>* ids) const {
+        if (ids == nullptr) {
+            cout << "No matching areas.\n";
+            return;
+        }
+        vector<int> sorted(ids->begin(), ids->end());
+        sort(sorted.begin(), sorted.end());
+        displayAreaIds(sorted);
+    }
+
+public:
+
+    Graph() {
+        orderedIndexes[size_t(AreaField::WasteQuantity)].reset(new OrderedIndex());
+    }
+
+    // Ordered index on a numeric field, built from the columns on first use
+    const OrderedIndex& orderedIndex(AreaField field) const {
+        unique_ptr<OrderedIndex>& index = orderedIndexes[size_t(field)];
+        if (!index) {
+            index.reset(new OrderedIndex());
+            for (size_t row = 0; row < columns.size(); ++row) {
+                index->add(fieldValue(row, field), columns.id[row]);
+            }
+        }
+        return *index;
+    }
+
+    // IDs of the 'n' areas with the largest values of a field, largest first
+    vector<int> topAreas(AreaField field, size_t n) const {
+        return orderedIndex(field).top(n);
+    }
+
+    // IDs of the areas whose field value lies in [low, high], smallest first
+    vector<int> areasInRange(AreaField field, double low, double high) const {
+        return orderedIndex(field).range(low, high);
+    }
+
+    // Read-only access to the column arrays
+    const AreaColumns& areaColumns() const {
+        return columns;
+    }
+
+    // Number of areas in the system
+    size_t areaCount() const {
+        return columns.size();
+    }
+
+    // Check whether an area with the given ID exists
+    bool hasArea(int id) const {
+        return rowOf.find(id) != rowOf.end();
+    }
+
+    // Copy the data of an area into 'area', returns false if the ID does not exist
+    bool getArea(int id, Area& area) const {
+        auto it = rowOf.find(id);
+        if (it == rowOf.end()) {
+            return false;
+        }
+        area = columns.row(it->second);
+        return true;
+    }
+
+    // Apply a batch of sensor readings in one pass. Readings for the same area are
+    // coalesced so only the newest one is applied; readings older than the area's
+    // last update are ignored
+    IngestStats ingestReadings(const vector<SensorReading>& readings) {
+        auto start = chrono::steady_clock::now();
+        IngestStats stats;
+        stats.received = readings.size();
+
+        // Row -> index of the newest reading for that row in this batch
+        unordered_map<size_t, size_t> newest;
+        newest.reserve(readings.size());
+        for (size_t i = 0; i < readings.size(); ++i) {
+            auto row = rowOf.find(readings[i].areaId);
+            if (row == rowOf.end()) {
+                ++stats.unknownArea;
+                continue;
+            }
+            if (!isfinite(readings[i].wasteQuantity)) {
+                ++stats.invalid;
+                continue;
+            }
+            auto slot = newest.emplace(row->second, i);
+            if (!slot.second) {
+                ++stats.coalesced;
+                if (readings[i].timestamp >= readings[slot.first->second].timestamp) {
+                    slot.first->second = i;
+                }
+            }
+        }
+
+        // Keep every accepted reading in the time series, oldest first per area
+        vector<size_t> known;
+        known.reserve(readings.size());
+        for (size_t i = 0; i < readings.size(); ++i) {
+            if (rowOf.count(readings[i].areaId) && isfinite(readings[i].wasteQuantity)) {
+                known.push_back(i);
+            }
+        }
+        stable_sort(known.begin(), known.end(), [&readings](size_t a, size_t b) {
+            return readings[a].areaId != readings[b].areaId ? readings[a].areaId < readings[b].areaId
+                                                            : readings[a].timestamp < readings[b].timestamp;
+        });
+        // Every reading kept in the history also goes through the anomaly detector and
+        // is logged, so recovery rebuilds the same time series
+        vector<WasteAlert> alerts;
+        vector<bool> logged(readings.size(), false);
+        for (size_t i : known) {
+            const SensorReading& reading = readings[i];
+            if (wasteHistory.append(reading.areaId, reading.timestamp, reading.wasteQuantity)) {
+                anomalyDetector.observe(reading.areaId, reading.wasteQuantity, reading.timestamp, alerts);
+                logReading(reading.areaId, reading.wasteQuantity, reading.timestamp);
+                logged[i] = true;
+            }
+        }
+
+        for (const auto& entry : newest) {
+            const SensorReading& reading = readings[entry.second];
+            if (reading.timestamp < columns.lastUpdated[entry.first]) {
+                ++stats.stale;
+                continue;
+            }
+            applyReading(entry.first, reading.wasteQuantity, reading.timestamp);
+            if (!logged[entry.second]) {
+                logReading(reading.areaId, reading.wasteQuantity, reading.timestamp);
+            }
+            ++stats.applied;
+        }
+
+        anomalyDetector.advance(time(0), alerts);
+        recordAlerts(alerts);
+        stats.alerts = alerts.size();
+
+        stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        ingestTotals.add(stats);
+        endMutation(true, "Ingested " + to_string(stats.applied) + " readings");
+        return stats;
+    }
+
+    // Compute density, impact and per-capita waste for every area in one call. The
+    // rows are split into blocks that worker threads run through the batch kernels
+    AreaMetrics computeAreaMetrics() const {
+        size_t n = columns.size();
+        AreaMetrics metrics;
+        metrics.id = columns.id;
+        metrics.wasteDensity.resize(n);
+        metrics.environmentalImpact.resize(n);
+        metrics.wastePerCapita.resize(n);
+
+        const size_t BLOCK_ROWS = 1 << 16;
+        size_t blocks = (n + BLOCK_ROWS - 1) / BLOCK_ROWS;
+        runParallel(blocks, [&](size_t block) {
+            size_t begin = block * BLOCK_ROWS;
+            size_t end = min(n, begin + BLOCK_ROWS);
+            wasteDensityKernel(columns.wasteQuantity.data(), columns.areaSize.data(),
+                               metrics.wasteDensity.data(), begin, end);
+            environmentalImpactKernel(columns.environmentalImpactScore.data(), columns.wasteQuantity.data(),
+                                      metrics.environmentalImpact.data(), begin, end);
+            wastePerCapitaKernel(columns.wasteQuantity.data(), columns.population.data(),
+                                 metrics.wastePerCapita.data(), begin, end);
+        });
+        return metrics;
+    }
+
+    // Method to display the per-area metrics of the whole registry
+
+    void displayAreaMetrics() const {
+        AreaMetrics metrics = computeAreaMetrics();
+        cout << "\nPer-area metrics:\n";
+        ReportTable table({"AID", "Density (t/sq.km)", "Environ Impact", "Waste per capita (t)"},
+                          {ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::RIGHT});
+        for (size_t row = 0; row < metrics.id.size(); ++row) {
+            table.cell(metrics.id[row])
+                 .cell(metrics.wasteDensity[row])
+                 .cell(metrics.environmentalImpact[row])
+                 .cell(metrics.wastePerCapita[row]);
+        }
+        table.render(cout);
+    }
+
+    // Method to compute the budget allocation that maximizes the modelled reduction of
+    // environmental impact for a fixed total budget (see BudgetSolver)
+
+    BudgetPlan optimizeBudget(double totalBudget, const BudgetPlanOptions& options) const {
+        auto start = chrono::steady_clock::now();
+        size_t n = columns.size();
+        BudgetPlan plan;
+
+        // Capped categories become solver groups
+        unordered_map<Symbol, int> groupOf;
+        BudgetProblem problem;
+        for (const auto& cap : options.categoryCap) {
+            Symbol symbol;
+            if (columns.symbols->find(cap.first, symbol)) {
+                groupOf[symbol] = static_cast<int>(problem.groupCap.size());
+                problem.groupCap.push_back(cap.second);
+            }
+        }
+
+        problem.totalBudget = totalBudget;
+        problem.gain.resize(n);
+        problem.scale.resize(n);
+        problem.minimum.resize(n);
+        problem.group.resize(n);
+        for (size_t row = 0; row < n; ++row) {
+            problem.scale[row] = columns.wasteQuantity[row] * options.costPerTon;
+            problem.gain[row] = problem.scale[row] > 0 ? rowImpact(row) / problem.scale[row] : 0;
+            auto minimum = options.areaMinimum.find(columns.id[row]);
+            problem.minimum[row] = minimum != options.areaMinimum.end() ? minimum->second : options.defaultMinimum;
+            auto group = groupOf.find(columns.wasteCategory[row]);
+            problem.group[row] = group != groupOf.end() ? group->second : -1;
+        }
+
+        BudgetSolution solution = BudgetSolver(problem).solve();
+        plan.error = solution.error;
+        if (plan.error.empty()) {
+            plan.id = columns.id;
+            plan.current = columns.budgetAllocated;
+            plan.proposed = std::move(solution.budget);
+            plan.unallocated = solution.unallocated;
+            for (size_t row = 0; row < n; ++row) {
+                double impact = rowImpact(row), scale = problem.scale[row];
+                if (scale > 0) {
+                    plan.currentReduction += impact * (1 - exp(-plan.current[row] / scale));
+                    plan.proposedReduction += impact * (1 - exp(-plan.proposed[row] / scale));
+                }
+            }
+        }
+        plan.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return plan;
+    }
+
+    // Method to display a budget plan as a diff against the current allocation,
+    // largest changes first
+
+    void displayBudgetPlan(const BudgetPlan& plan, size_t maxRows) const {
+        if (!plan.error.empty()) {
+            cout << "No allocation possible: " << plan.error << "\n";
+            return;
+        }
+        vector<size_t> order;
+        double currentTotal = 0, proposedTotal = 0;
+        for (size_t i = 0; i < plan.id.size(); ++i) {
+            currentTotal += plan.current[i];
+            proposedTotal += plan.proposed[i];
+            if (fabs(plan.proposed[i] - plan.current[i]) >= 0.005) {
+                order.push_back(i);
+            }
+        }
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return fabs(plan.proposed[a] - plan.current[a]) > fabs(plan.proposed[b] - plan.current[b]);
+        });
+
+        auto money = [](double value) {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%.2f", value);
+            return string(buffer);
+        };
+        cout << "\nBudget plan computed in " << fixed << setprecision(3) << plan.seconds << " s\n"
+             << "Total budget: " << setprecision(2) << currentTotal << " -> " << proposedTotal
+             << " (unallocated " << plan.unallocated << ")\n"
+             << "Modelled impact reduction: " << setprecision(3) << plan.currentReduction << " -> "
+             << plan.proposedReduction << "\n"
+             << defaultfloat << setprecision(6) << order.size() << " of " << plan.id.size() << " areas change\n";
+
+        ReportTable table({"AID", "Area Name", "Waste Cat", "Current Budget", "Proposed Budget", "Change"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::LEFT, ReportTable::RIGHT,
+                           ReportTable::RIGHT, ReportTable::RIGHT});
+        for (size_t k = 0; k < order.size() && k < maxRows; ++k) {
+            size_t i = order[k];
+            auto row = rowOf.find(plan.id[i]);
+            table.cell(plan.id[i])
+                 .cell(row != rowOf.end() ? columns.name[row->second] : string("(deleted)"))
+                 .cell(row != rowOf.end() ? columns.symbols->name(columns.wasteCategory[row->second]) : string())
+                 .cell(money(plan.current[i]))
+                 .cell(money(plan.proposed[i]))
+                 .cell((plan.proposed[i] >= plan.current[i] ? "+" : "") + money(plan.proposed[i] - plan.current[i]));
+        }
+        table.render(cout);
+    }
+
+    // Method to write the proposed budgets of a plan into the registry
+
+    size_t applyBudgetPlan(const BudgetPlan& plan) {
+        size_t changed = 0;
+        time_t now = time(0);
+        for (size_t i = 0; i < plan.id.size(); ++i) {
+            auto it = rowOf.find(plan.id[i]);
+            if (it == rowOf.end() || columns.budgetAllocated[it->second] == plan.proposed[i]) {
+                continue;
+            }
+            Area area = columns.row(it->second);
+            area.budgetAllocated = plan.proposed[i];
+            area.lastUpdated = now;
+            updateRow(it->second, area);
+            ++changed;
+        }
+        endMutation(true, "Applied budget plan to " + to_string(changed) + " areas");
+        return changed;
+    }
+
+    // Waste quantity history of every area
+    const WasteTimeSeries& wasteSeries() const {
+        return wasteHistory;
+    }
+
+    // Method to display the daily waste history of an area for the last 'days' days
+
+    void displayDailyWasteHistory(int id, int days) const {
+        time_t now = time(0);
+        time_t from = now - now % WasteTimeSeries::DAY - (days - 1) * WasteTimeSeries::DAY;
+        vector<RollupBucket> buckets = wasteHistory.daily(id, from, now);
+
+        cout << "\nDaily waste history of area " << id << " (last " << days << " days):\n";
+        if (buckets.empty()) {
+            cout << "No readings recorded.\n";
+            return;
+        }
+        ReportTable table({"Date (UTC)", "Readings", "Mean (t)", "Max (t)", "Last (t)"},
+                          {ReportTable::LEFT, ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::RIGHT,
+                           ReportTable::RIGHT});
+        for (const RollupBucket& bucket : buckets) {
+            char date[16];
+            struct tm utc;
+#ifdef _WIN32
+            gmtime_s(&utc, &bucket.start);
+#else
+            gmtime_r(&bucket.start, &utc);
+#endif
+            strftime(date, sizeof(date), "%Y-%m-%d", &utc);
+            table.cell(date).cell(bucket.count).cell(bucket.mean()).cell(bucket.max).cell(bucket.last);
+        }
+        table.render(cout);
+    }
+
+    // Days of daily history the forecasting models are fitted on
+    static const int FORECAST_HISTORY_DAYS = 56;
+
+    // Method to refit a forecasting model for every area in one parallel pass and
+    // forecast its waste quantity for the next days; row-aligned with the columns
+
+    vector<WasteForecast> forecastWaste(time_t now = time(0)) const {
+        size_t n = columns.size();
+        vector<WasteForecast> forecasts(n);
+        time_t today = now - now % WasteTimeSeries::DAY;
+        time_t from = today - (FORECAST_HISTORY_DAYS - 1) * WasteTimeSeries::DAY;
+
+        const size_t BLOCK_ROWS = 1 << 10;
+        runParallel((n + BLOCK_ROWS - 1) / BLOCK_ROWS, [&](size_t block) {
+            vector<double> history;
+            for (size_t row = block * BLOCK_ROWS; row < min(n, (block + 1) * BLOCK_ROWS); ++row) {
+                // One value per day up to today; days without readings keep the previous value
+                vector<RollupBucket> buckets = wasteHistory.daily(columns.id[row], from, now);
+                history.clear();
+                if (buckets.empty()) {
+                    history.push_back(columns.wasteQuantity[row]);
+                } else {
+                    size_t next = 0;
+                    double value = buckets[0].mean();
+                    for (time_t day = buckets[0].start; day <= today; day += WasteTimeSeries::DAY) {
+                        if (next < buckets.size() && buckets[next].start == day) {
+                            value = buckets[next++].mean();
+                        }
+                        history.push_back(value);
+                    }
+                }
+                forecasts[row] = WasteForecaster::fit(history);
+                forecasts[row].areaId = columns.id[row];
+            }
+        });
+        return forecasts;
+    }
+
+    // Method to display the next-day and next-week waste forecasts, largest next-week forecast first
+
+    void displayWasteForecasts(size_t maxRows) const {
+        auto start = chrono::steady_clock::now();
+        vector<WasteForecast> forecasts = forecastWaste();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "\nRefitted " << forecasts.size() << " area forecasts in " << fixed << setprecision(3) << seconds
+             << " s" << defaultfloat << setprecision(6) << "\n";
+
+        sort(forecasts.begin(), forecasts.end(), [](const WasteForecast& a, const WasteForecast& b) {
+            return a.nextWeek() > b.nextWeek();
+        });
+        ReportTable table({"AID", "Area Name", "Model", "History (days)", "Current (t)", "Next Day (t)",
+                           "Next Week (t)", "RMSE (t)"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::LEFT, ReportTable::RIGHT,
+                           ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::RIGHT});
+        for (size_t i = 0; i < forecasts.size() && i < maxRows; ++i) {
+            const WasteForecast& forecast = forecasts[i];
+            size_t row = rowOf.at(forecast.areaId);
+            table.cell(forecast.areaId)
+                 .cell(columns.name[row])
+                 .cell(forecastModelName(forecast.model))
+                 .cell(forecast.historyDays)
+                 .cell(columns.wasteQuantity[row])
+                 .cell(forecast.nextDay())
+                 .cell(forecast.nextWeek())
+                 .cell(forecast.rmse);
+        }
+        table.render(cout);
+    }
+
+    // Method to check every area for staleness at 'now'; returns the number of new alerts
+
+    size_t checkStaleAreas(time_t now = time(0)) {
+        vector<WasteAlert> alerts;
+        anomalyDetector.advance(now, alerts);
+        recordAlerts(alerts);
+        return alerts.size();
+    }
+
+    // Most recent anomaly alerts, oldest first
+    const deque<WasteAlert>& recentAlerts() const {
+        return alertLog;
+    }
+
+    // Change the detector thresholds; every area is tracked again from its current value
+    void setAnomalySettings(const WasteAnomalyDetector::Settings& settings) {
+        anomalyDetector = WasteAnomalyDetector(settings);
+        for (size_t row = 0; row < columns.size(); ++row) {
+            anomalyDetector.track(columns.id[row], columns.wasteQuantity[row], columns.lastUpdated[row]);
+        }
+    }
+
+    // Method to display the most recent anomaly alerts, newest first
+
+    void displayRecentAlerts(size_t maxRows) const {
+        cout << "\nRecent anomaly alerts (" << alertLog.size() << " kept):\n";
+        if (alertLog.empty()) {
+            cout << "No anomalies detected.\n";
+            return;
+        }
+        ReportTable table({"AID", "Area Name", "Alert", "Time", "Value (t)", "Expected (t)", "Score"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::LEFT, ReportTable::LEFT,
+                           ReportTable::RIGHT, ReportTable::RIGHT, ReportTable::RIGHT});
+        size_t shown = 0;
+        for (auto it = alertLog.rbegin(); it != alertLog.rend() && shown < maxRows; ++it, ++shown) {
+            auto row = rowOf.find(it->areaId);
+            table.cell(it->areaId)
+                 .cell(row != rowOf.end() ? columns.name[row->second] : string("(deleted)"))
+                 .cell(anomalyTypeName(it->type))
+                 .cell(formatTimestamp(it->time))
+                 .cell(it->value)
+                 .cell(it->expected)
+                 .cell(it->score);
+        }
+        table.render(cout);
+    }
+
+    // Counters accumulated over every ingest batch so far
+    const IngestStats& ingestCounters() const {
+        return ingestTotals;
+    }
+
+    // Method to add a new area to the system
+    void addArea(int id, string name, double wasteQuantity, string wasteCategory, double areaSize,
+                 string location, int population, time_t lastUpdated, string wasteManagementStrategy,
+                 double environmentalImpactScore, double budgetAllocated,
+                 double latitude = numeric_limits<double>::quiet_NaN(),
+                 double longitude = numeric_limits<double>::quiet_NaN()) {
+        // Store the area as a row in the columns, replacing any area with the same ID
+        insertRow(Area(id, name, wasteQuantity, wasteCategory, areaSize, location, population,
+                       lastUpdated, wasteManagementStrategy, environmentalImpactScore, budgetAllocated,
+                       latitude, longitude));
+        endMutation(false, "Added area " + to_string(id)); // Logged records are committed with the next group
+    }
+
+
+    // Method to display all areas in the system in tabular format. 'firstRow' and
+    // 'maxRows' select one page of the table so huge registries can be browsed
+
+    void displayAreas(size_t firstRow = 0, size_t maxRows = numeric_limits<size_t>::max()) const {
+        cout << "\nAreas in the system (sorted by waste quantity):\n";
+
+        // Walk the waste quantity index from the largest value down, keeping only the requested page
+        ReportTable table = areaTable();
+        const OrderedIndex& byWaste = orderedIndex(AreaField::WasteQuantity);
+        size_t position = 0;
+        for (auto it = byWaste.rbegin(); it != byWaste.rend() && table.rowCount() < maxRows; ++it, ++position) {
+            if (position >= firstRow) {
+                addAreaRow(table, rowOf.at(it->second));
+            }
+        }
+        if (table.rowCount() == 0 && firstRow > 0) {
+            cout << "No areas on this page (" << columns.size() << " areas in total).\n";
+            return;
+        }
+        table.render(cout);
+        if (firstRow > 0 || table.rowCount() < columns.size()) {
+            cout << "(rows " << firstRow + 1 << "-" << firstRow + table.rowCount() << " of " << columns.size() << ")\n";
+        }
+    }
+
+    // Method to display the 'n' areas with the most waste, largest first
+
+    void displayTopAreasByWaste(size_t n) const {
+        cout << "\nTop " << n << " areas by waste quantity:\n";
+        displayAreaIds(topAreas(AreaField::WasteQuantity, n));
+    }
+
+    // Method to display the areas whose waste quantity lies in [low, high]
+
+    void displayAreasByWasteRange(double low, double high) const {
+        cout << "\nAreas with waste quantity between " << low << " and " << high << " tons:\n";
+        displayAreaIds(areasInRange(AreaField::WasteQuantity, low, high));
+    }
+
+    // Method to filter and display areas based on waste category
+
+    void displayAreasByCategory(const string& category) const {
+        // Displaying all areas matching the given waste category, looked up in the category index
+
+        cout << "\nAreas with waste category: " << category << "\n";
+        displayAreaIds(findSymbol(categoryIndex, category));
+    }
+
+    // Method to filter and display areas based on waste management strategy
+
+    void displayAreasByStrategy(const string& strategy) const {
+        cout << "\nAreas with waste management strategy: " << strategy << "\n";
+        displayAreaIds(findSymbol(strategyIndex, strategy));
+    }
+
+    // Method to filter and display areas based on location
+
+    void displayAreasByLocation(const string& location) const {
+        cout << "\nAreas in location: " << location << "\n";
+        displayAreaIds(findSymbol(locationIndex, location));
+    }
+
+    // Method to read a finite number from cin; on bad input the line is discarded
+    static bool readFiniteNumber(double& value) {
+        if (cin >> value && isfinite(value)) {
+            return true;
+        }
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return false;
+    }
+
+    // Method to parse "latitude longitude" typed by the user. Blank or "-" leaves the
+    // area unlocated (NaN); otherwise both must be finite and within range
+    static bool parseCoordinates(const string& text, double& latitude, double& longitude) {
+        istringstream in(text);
+        string first;
+        if (!(in >> first) || first == "-") {
+            latitude = longitude = numeric_limits<double>::quiet_NaN();
+            return !(in >> first); // Nothing may follow
+        }
+        in.clear();
+        in.str(text);
+        string rest;
+        return in >> latitude >> longitude && !(in >> rest) && isfinite(latitude) && isfinite(longitude) &&
+               fabs(latitude) <= 90 && fabs(longitude) <= 180;
+    }
+
+    // Method to update data for a specific area
+    void updateAreaData(int id) {
+        auto it = rowOf.find(id);
+        if (it != rowOf.end()) {
+            // If the area exists, allow updating its data
+            Area area = columns.row(it->second);
+
+            cout << "Enter new data for area ID " << id << " (" << area.name << "):\n";
+
+            cout << "Enter waste quantity: ";
+
+            if (!readFiniteNumber(area.wasteQuantity)) {
+                cout << "Invalid waste quantity, area not updated.\n";
+                return;
+            }
+
+            cout << "Enter waste category: ";
+
+            cin.ignore(); // To ignore the newline left by previous input
+
+            getline(cin, area.wasteCategory);
+
+            cout << "Enter area size: ";
+
+            if (!readFiniteNumber(area.areaSize)) {
+                cout << "Invalid area size, area not updated.\n";
+                return;
+            }
+
+            cout << "Enter location: ";
+
+            cin.ignore();
+
+            getline(cin, area.location);
+
+            cout << "Enter population: ";
+
+            cin >> area.population;
+
+            cout << "Enter waste management strategy: ";
+
+            cin.ignore();
+
+            getline(cin, area.wasteManagementStrategy);
+
+            cout << "Enter environmental impact score: ";
+
+            if (!readFiniteNumber(area.environmentalImpactScore)) {
+                cout << "Invalid environmental impact score, area not updated.\n";
+                return;
+            }
+
+            cout << "Enter budget allocated: ";
+
+            if (!readFiniteNumber(area.budgetAllocated)) {
+                cout << "Invalid budget, area not updated.\n";
+                return;
+            }
+
+            cout << "Enter latitude and longitude (blank or - if unknown): ";
+
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+            string coordinates;
+
+            getline(cin, coordinates);
+
+            if (!parseCoordinates(coordinates, area.latitude, area.longitude)) {
+                cout << "Invalid coordinates (latitude -90..90, longitude -180..180), area not updated.\n";
+                return;
+            }
+
+            area.lastUpdated = time(0); // Update the timestamp for when the data was updated
+
+            updateRow(it->second, area); // Write the new data back into the columns
+            endMutation(true, "Updated area " + to_string(id));
+
+            cout << "Area data updated successfully!\n";
+        } else {
+            cout << "Area ID " << id << " not found!\n";
+        }
+    }
+
+    // Method to delete an area by its ID
+
+    void deleteArea(int id) {
+
+        auto it = rowOf.find(id);
+
+        if (it != rowOf.end()) {
+
+            // If area exists, remove its row from the columns
+
+            eraseRow(it->second);
+            endMutation(true, "Deleted area " + to_string(id));
+
+            cout << "Area ID " << id << " has been deleted.\n";
+        } else {
+            cout << "Area ID " << id << " not found!\n";
+        }
+    }
+
+    // Method to save data to a file (CSV export)
+
+    void saveToFile(const string& filename) const {
+
+        // Refuse text with line breaks rather than write a file that cannot be read back
+        const SymbolTable& symbols = *columns.symbols;
+        for (size_t row = 0; row < columns.size(); ++row) {
+            if (!csvWritable(columns.name[row]) || !csvWritable(symbols.name(columns.wasteCategory[row])) ||
+                !csvWritable(symbols.name(columns.location[row])) ||
+                !csvWritable(symbols.name(columns.wasteManagementStrategy[row]))) {
+                cout << "Error saving data to file: area ID " << columns.id[row] << " has a line break in its text.\n";
+                return;
+            }
+        }
+
+        ofstream outFile(filename); // Open file for writing
+
+        if (outFile.is_open()) {
+
+            // Numbers are written in their shortest exact form, so they read back unchanged.
+            // Loop through all rows and write their data to the file in the same
+            // field order loadFromFile reads them back
+
+            for (size_t row = 0; row < columns.size(); ++row) {
+
+                outFile << columns.id[row] << ","
+
+                        << csvField(columns.name[row]) << ","
+
+                        << csvNumber(columns.wasteQuantity[row]) << ","
+
+                        << csvField(columns.symbols->name(columns.wasteCategory[row])) << ","
+
+                        << csvNumber(columns.areaSize[row]) << ","
+
+                        << csvField(columns.symbols->name(columns.location[row])) << ","
+
+                        << columns.population[row] << ","
+
+                        << csvField(columns.symbols->name(columns.wasteManagementStrategy[row])) << ","
+
+                        << csvNumber(columns.environmentalImpactScore[row]) << ","
+
+                        << csvNumber(columns.budgetAllocated[row]) << ","
+
+                        << static_cast<long long>(columns.lastUpdated[row]) << ","; // Timestamp in seconds since epoch
+
+                if (!std::isnan(columns.latitude[row])) { // Coordinates are left empty when unknown
+                    outFile << csvNumber(columns.latitude[row]) << "," << csvNumber(columns.longitude[row]) << "\n";
+                } else {
+                    outFile << ",\n";
+                }
+            }
+            cout << "Data saved to " << filename << endl;
+        } else {
+            cout << "Error saving data to file.\n";
+        }
+    }
+
+    // Method to load data from a file (CSV import, merged into the existing areas)
+    void loadFromFile(const string& filename) {
+        MappedFile file;
+        if (!file.open(filename)) {
+            cout << "Error loading data from file.\n";
+            return;
+        }
+
+        // Parse the file in parallel chunks, then merge the rows in file order
+        auto start = chrono::steady_clock::now();
+        vector<CsvChunkResult> chunks = AreaCsvParser::parse(file.data(), file.size());
+
+        size_t rowCount = 0;
+        for (const CsvChunkResult& chunk : chunks) {
+            rowCount += chunk.rows.size();
+        }
+        columns.reserve(columns.size() + rowCount);
+        rowOf.reserve(columns.size() + rowCount);
+
+        size_t errorCount = 0;
+        const size_t MAX_REPORTED_ERRORS = 20;
+        for (const CsvChunkResult& chunk : chunks) {
+            for (const CsvAreaRow& row : chunk.rows) {
+                insertRow(Area(row.id, csvFieldText(row.name, row.escapedFields & 1u), row.wasteQuantity,
+                               csvFieldText(row.wasteCategory, row.escapedFields & 2u), row.areaSize,
+                               csvFieldText(row.location, row.escapedFields & 4u), row.population,
+                               row.lastUpdated, csvFieldText(row.wasteManagementStrategy, row.escapedFields & 8u),
+                               row.environmentalImpactScore, row.budgetAllocated, row.latitude, row.longitude));
+            }
+            // Report malformed rows with their line numbers
+            for (const CsvImportError& error : chunk.errors) {
+                if (errorCount < MAX_REPORTED_ERRORS) {
+                    cout << filename << ":" << error.line << ": " << error.message << "\n";
+                }
+                ++errorCount;
+            }
+        }
+        endMutation(true, "Loaded " + filename);
+        if (errorCount > MAX_REPORTED_ERRORS) {
+            cout << "... " << errorCount - MAX_REPORTED_ERRORS << " more malformed rows\n";
+        }
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Data loaded from " << filename << ": " << rowCount << " rows imported, "
+             << errorCount << " rejected in " << fixed << setprecision(3) << seconds << " s"
+             << defaultfloat << setprecision(6) << endl;
+    }
+
+    // Write the whole registry as a binary snapshot; on failure 'error' says why
+    bool writeSnapshot(const string& filename, string& error) const {
+        size_t n = columns.size();
+
+        // Numeric columns first, as raw arrays
+        vector<char> payload;
+        vector<int64_t> lastUpdated(columns.lastUpdated.begin(), columns.lastUpdated.end());
+        appendSnapshotArray(payload, columns.id.data(), n);
+        appendSnapshotArray(payload, columns.wasteQuantity.data(), n);
+        appendSnapshotArray(payload, columns.areaSize.data(), n);
+        appendSnapshotArray(payload, columns.population.data(), n);
+        appendSnapshotArray(payload, lastUpdated.data(), n);
+        appendSnapshotArray(payload, columns.environmentalImpactScore.data(), n);
+        appendSnapshotArray(payload, columns.budgetAllocated.data(), n);
+
+        // Area names, then the symbol dictionary and the symbol columns
+        appendSnapshotStrings(payload, columns.name);
+        vector<string> dictionary;
+        dictionary.reserve(columns.symbols->size());
+        for (Symbol symbol = 0; symbol < columns.symbols->size(); ++symbol) {
+            dictionary.push_back(columns.symbols->name(symbol));
+        }
+        uint64_t dictionarySize = dictionary.size();
+        appendSnapshotArray(payload, &dictionarySize, 1);
+        appendSnapshotStrings(payload, dictionary);
+        appendSnapshotArray(payload, columns.wasteCategory.data(), n);
+        appendSnapshotArray(payload, columns.location.data(), n);
+        appendSnapshotArray(payload, columns.wasteManagementStrategy.data(), n);
+        appendSnapshotArray(payload, columns.latitude.data(), n);
+        appendSnapshotArray(payload, columns.longitude.data(), n);
+        wasteHistory.appendToSnapshot(payload); // Readings are only in the log until a checkpoint
+
+        SnapshotHeader header;
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.endianMark = SNAPSHOT_ENDIAN_MARK;
+        header.rowCount = n;
+        header.payloadSize = payload.size();
+        header.checksum = fnv1a64(payload.data(), payload.size());
+
+        // Write to a temporary file and rename it so a crash never leaves a half-written snapshot
+        string tempName = filename + ".tmp";
+        {
+            ofstream outFile(tempName, ios::binary | ios::trunc);
+            if (!outFile.is_open()) {
+                error = "cannot open " + tempName;
+                return false;
+            }
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            outFile.write(payload.data(), payload.size());
+            if (!outFile) {
+                error = "cannot write " + tempName;
+                return false;
+            }
+        }
+        if (!syncFileToDisk(tempName)) {
+            error = "cannot sync " + tempName;
+            return false;
+        }
+        if (rename(tempName.c_str(), filename.c_str()) != 0) {
+            error = "cannot rename " + tempName + " to " + filename;
+            return false;
+        }
+        return true;
+    }
+
+    // Replace the registry with the contents of a binary snapshot; on failure 'error' says why
+    bool readSnapshot(const string& filename, string& error) {
+        MappedFile file;
+        if (!file.open(filename)) {
+            error = "cannot open " + filename;
+            return false;
+        }
+
+        // Validate the header before touching the payload
+        SnapshotHeader header;
+        if (file.size() < sizeof(header)) {
+            error = "file is truncated";
+            return false;
+        }
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.endianMark != SNAPSHOT_ENDIAN_MARK) {
+            error = "not a snapshot file";
+            return false;
+        }
+        if (header.version < 1 || header.version > SNAPSHOT_VERSION) {
+            error = "unsupported snapshot version " + to_string(header.version);
+            return false;
+        }
+        const char* payload = file.data() + sizeof(header);
+        if (file.size() - sizeof(header) != header.payloadSize) {
+            error = "file is truncated";
+            return false;
+        }
+        if (fnv1a64(payload, header.payloadSize) != header.checksum) {
+            error = "checksum mismatch, file is corrupted";
+            return false;
+        }
+
+        // Copy the columns out of the mapped file
+        size_t n = header.rowCount;
+        AreaColumns loaded;
+        vector<int64_t> lastUpdated;
+        SnapshotReader reader{payload, payload + header.payloadSize};
+        bool ok = reader.readArray(loaded.id, n) &&
+                  reader.readArray(loaded.wasteQuantity, n) &&
+                  reader.readArray(loaded.areaSize, n) &&
+                  reader.readArray(loaded.population, n) &&
+                  reader.readArray(lastUpdated, n) &&
+                  reader.readArray(loaded.environmentalImpactScore, n) &&
+                  reader.readArray(loaded.budgetAllocated, n) &&
+                  reader.readStrings(loaded.name, n);
+        if (ok && header.version == 1) {
+            // Version 1 stored category, location and strategy as plain strings
+            vector<string> category, location, strategy;
+            ok = reader.readStrings(category, n) && reader.readStrings(location, n) &&
+                 reader.readStrings(strategy, n);
+            for (size_t row = 0; ok && row < n; ++row) {
+                loaded.wasteCategory.push_back(loaded.symbols->intern(category[row]));
+                loaded.location.push_back(loaded.symbols->intern(location[row]));
+                loaded.wasteManagementStrategy.push_back(loaded.symbols->intern(strategy[row]));
+            }
+        } else if (ok) {
+            // Intern the dictionary, then map the stored symbols onto the new table
+            vector<uint64_t> dictionarySize;
+            vector<string> dictionary;
+            ok = reader.readArray(dictionarySize, 1) && reader.readStrings(dictionary, dictionarySize[0]) &&
+                 reader.readArray(loaded.wasteCategory, n) && reader.readArray(loaded.location, n) &&
+                 reader.readArray(loaded.wasteManagementStrategy, n);
+            vector<Symbol> remap;
+            for (size_t i = 0; ok && i < dictionary.size(); ++i) {
+                remap.push_back(loaded.symbols->intern(dictionary[i]));
+            }
+            for (vector<Symbol>* column : {&loaded.wasteCategory, &loaded.location, &loaded.wasteManagementStrategy}) {
+                for (size_t row = 0; ok && row < n; ++row) {
+                    Symbol& symbol = (*column)[row];
+                    ok = symbol < remap.size();
+                    if (ok) {
+                        symbol = remap[symbol];
+                    }
+                }
+            }
+        }
+        if (header.version >= 3) {
+            ok = ok && reader.readArray(loaded.latitude, n) && reader.readArray(loaded.longitude, n);
+        } else if (ok) {
+            // Older snapshots have no coordinates
+            loaded.latitude.assign(n, numeric_limits<double>::quiet_NaN());
+            loaded.longitude.assign(n, numeric_limits<double>::quiet_NaN());
+        }
+        WasteTimeSeries loadedHistory;
+        bool hasHistory = header.version >= 4;
+        if (hasHistory) {
+            ok = ok && loadedHistory.readFromSnapshot(reader);
+        }
+        if (!ok) {
+            error = "file is corrupted";
+            return false;
+        }
+        loaded.lastUpdated.assign(lastUpdated.begin(), lastUpdated.end());
+
+        columns = std::move(loaded);
+        rebuildIndex();
+        if (hasHistory) {
+            wasteHistory = std::move(loadedHistory); // Older snapshots keep one point per area
+        }
+        return true;
+    }
+
+    // Write the registry as a columnar file for analytics tools; on failure 'error' says why
+    bool writeColumnar(const string& filename, string& error) const {
+        ColumnarWriter writer;
+        auto addInt64 = [&](const string& name, function<int64_t(size_t)> value) {
+            writer.addColumn(name, ColumnType::Int64, [value](size_t begin, size_t end, vector<char>& out) {
+                vector<int64_t> values;
+                values.reserve(end - begin);
+                for (size_t row = begin; row < end; ++row) {
+                    values.push_back(value(row));
+                }
+                return ColumnarCodec::encodeInt64(values, out);
+            });
+        };
+        auto addDouble = [&](const string& name, const vector<double>& column) {
+            writer.addColumn(name, ColumnType::Double, [&column](size_t begin, size_t end, vector<char>& out) {
+                return ColumnarCodec::encodeDouble(vector<double>(column.begin() + begin, column.begin() + end), out);
+            });
+        };
+        auto addString = [&](const string& name, function<string_view(size_t)> value) {
+            writer.addColumn(name, ColumnType::String, [value](size_t begin, size_t end, vector<char>& out) {
+                vector<string_view> values;
+                values.reserve(end - begin);
+                for (size_t row = begin; row < end; ++row) {
+                    values.push_back(value(row));
+                }
+                return ColumnarCodec::encodeStrings(values, out);
+            });
+        };
+
+        const AreaColumns& c = columns;
+        addInt64("id", [&c](size_t row) { return c.id[row]; });
+        addString("name", [&c](size_t row) { return string_view(c.name[row]); });
+        addDouble("wasteQuantity", c.wasteQuantity);
+        addString("wasteCategory", [&c](size_t row) { return string_view(c.symbols->name(c.wasteCategory[row])); });
+        addDouble("areaSize", c.areaSize);
+        addString("location", [&c](size_t row) { return string_view(c.symbols->name(c.location[row])); });
+        addInt64("population", [&c](size_t row) { return c.population[row]; });
+        addInt64("lastUpdated", [&c](size_t row) { return static_cast<int64_t>(c.lastUpdated[row]); });
+        addString("wasteManagementStrategy",
+                  [&c](size_t row) { return string_view(c.symbols->name(c.wasteManagementStrategy[row])); });
+        addDouble("environmentalImpactScore", c.environmentalImpactScore);
+        addDouble("budgetAllocated", c.budgetAllocated);
+        addDouble("latitude", c.latitude);
+        addDouble("longitude", c.longitude);
+        return writer.write(filename, c.size(), error);
+    }
+
+    // Method to export the registry as a columnar file
+    bool saveColumnar(const string& filename) const {
+        string error;
+        if (!writeColumnar(filename, error)) {
+            cout << "Error exporting columnar file: " << error << "\n";
+            return false;
+        }
+        cout << "Columnar export of " << columns.size() << " areas written to " << filename << endl;
+        return true;
+    }
+
+    // Method to save the whole registry as a binary snapshot
+    bool saveSnapshot(const string& filename) const {
+        string error;
+        if (!writeSnapshot(filename, error)) {
+            cout << "Error saving snapshot: " << error << "\n";
+            return false;
+        }
+        cout << "Snapshot of " << columns.size() << " areas saved to " << filename << endl;
+        return true;
+    }
+
+    // Method to replace the registry with the contents of a binary snapshot
+    bool loadSnapshot(const string& filename) {
+        string error;
+        if (!readSnapshot(filename, error)) {
+            cout << "Error loading snapshot " << filename << ": " << error << "\n";
+            return false;
+        }
+        if (wal) {
+            checkpoint(); // The log no longer applies on top of the old checkpoint
+        }
+        if (history) {
+            history->commit(time(0), "Loaded snapshot " + filename);
+        }
+        cout << "Snapshot of " << columns.size() << " areas loaded from " << filename << endl;
+        return true;
+    }
+
+    // Turn on durable storage. If the snapshot or log already exist the registry is
+    // recovered from them (snapshot, then every intact log record); otherwise the
+    // current areas become the first checkpoint
+    bool openDurableStore(const string& snapshotFile, const string& logFile) {
+        wal.reset(); // Nothing is logged while recovering
+        ifstream snapshotProbe(snapshotFile), logProbe(logFile);
+        bool recover = snapshotProbe.good() || logProbe.good();
+        snapshotProbe.close();
+        logProbe.close();
+
+        size_t replayed = 0;
+        bool tornTail = false;
+        if (recover) {
+            string error;
+            if (ifstream(snapshotFile).good()) {
+                if (!readSnapshot(snapshotFile, error)) {
+                    cout << "Error loading snapshot " << snapshotFile << ": " << error << "\n";
+                    return false;
+                }
+            } else {
+                columns.clear();
+                rebuildIndex();
+            }
+
+            // Replay the log; records that are already in the snapshot are harmless to
+            // apply again because every record sets values rather than adjusting them
+            size_t validBytes = AreaWriteAheadLog::replay(logFile, [&](const WalRecord& record) {
+                auto it = rowOf.find(record.area.id);
+                if (record.op == WalOp::Upsert) {
+                    insertRow(record.area);
+                } else if (record.op == WalOp::Erase && it != rowOf.end()) {
+                    eraseRow(it->second);
+                } else if (record.op == WalOp::Reading && it != rowOf.end()) {
+                    replayReading(it->second, record.area.wasteQuantity, record.area.lastUpdated);
+                }
+                ++replayed;
+            });
+            MappedFile logContents;
+            tornTail = logContents.open(logFile) && validBytes < logContents.size();
+        }
+
+        checkpointPath = snapshotFile;
+        wal.reset(new AreaWriteAheadLog());
+        if (!wal->open(logFile, false)) {
+            cout << "Error opening write-ahead log " << logFile << "\n";
+            wal.reset();
+            return false;
+        }
+        loggedSinceCheckpoint = replayed;
+        if (!recover || tornTail) {
+            checkpoint(); // Start from a clean snapshot and drop any torn record
+        }
+        if (published) {
+            published->publish(); // Replayed records become visible as one version
+        }
+        if (history) {
+            history->commit(time(0), recover ? "Recovered from " + logFile : "Opened " + snapshotFile);
+        }
+        cout << (recover ? "Recovered " : "Durable storage enabled for ") << columns.size() << " areas";
+        if (recover) {
+            cout << " (" << replayed << " log records replayed" << (tornTail ? ", torn tail discarded" : "") << ")";
+        }
+        cout << endl;
+        return true;
+    }
+
+    // Check whether changes are being written to a durable store
+    bool isDurable() const {
+        return wal != nullptr;
+    }
+
+    // Compact the write-ahead log into the checkpoint snapshot
+    bool checkpoint() {
+        if (!wal) {
+            cout << "Durable storage is not enabled.\n";
+            return false;
+        }
+        wal->commit();
+        string error;
+        if (!writeSnapshot(checkpointPath, error)) {
+            cout << "Error writing checkpoint: " << error << "\n";
+            return false;
+        }
+        // A crash before the reset only means the old records are replayed again
+        loggedSinceCheckpoint = 0;
+        if (!wal->reset()) {
+            cout << "Error: could not reopen the write-ahead log after the checkpoint\n";
+            return false;
+        }
+        return true;
+    }
+
+    // Write the pending log group now instead of waiting for the group deadline
+    void flushLog() {
+        if (wal) {
+            wal->commit();
+        }
+    }
+
+    // Number of logged records after which the log is compacted automatically
+    void setCheckpointInterval(size_t records) {
+        checkpointInterval = records;
+    }
+
+    // Start publishing read-only snapshots that other threads can query while this
+    // Graph keeps being modified. Every public mutation publishes one new version.
+    // Call before starting the reader threads; the Graph itself stays single-writer
+    void enableConcurrentReads() {
+        if (!published) {
+            published.reset(new ConcurrentAreaRegistry());
+            published->reset(columns);
+        }
+    }
+
+    // Latest published snapshot (nullptr unless concurrent reads are enabled); safe to
+    // call from any thread
+    shared_ptr<const RegistrySnapshot> concurrentSnapshot() const {
+        return published ? published->snapshot() : nullptr;
+    }
+
+    // Start keeping versions of the registry. Each public mutation commits one
+    // version that shares all unchanged areas with the previous one, so old versions
+    // stay readable and cost memory only for what changed. At most 'maxVersions'
+    // versions spanning 'maxAge' seconds are kept (0 = no limit)
+    void enableVersionHistory(size_t maxVersions, time_t maxAge) {
+        if (!history) {
+            history.reset(new VersionedAreaHistory(maxVersions, maxAge));
+            history->replaceAll(columns);
+            history->commit(time(0), "Version history started");
+        }
+    }
+
+    // Kept versions, oldest first (empty unless version history is enabled)
+    vector<RegistryVersion> registryVersions() const {
+        return history ? vector<RegistryVersion>(history->versions().begin(), history->versions().end())
+                       : vector<RegistryVersion>();
+    }
+
+    // The registry as it was at 'when', or nullptr if no version existed yet
+    const RegistryVersion* registryAt(time_t when) const {
+        return history ? history->at(when) : nullptr;
+    }
+
+    // An area as it was at 'when', or nullptr if it did not exist then
+    shared_ptr<const Area> areaAt(int id, time_t when) const {
+        const RegistryVersion* version = registryAt(when);
+        return version ? version->areas.find(id) : nullptr;
+    }
+
+    // Areas changed between two version numbers; false if either version is unknown
+    bool diffVersions(uint64_t from, uint64_t to, vector<AreaChange>& changes) const {
+        const RegistryVersion* before = history ? history->version(from) : nullptr;
+        const RegistryVersion* after = history ? history->version(to) : nullptr;
+        if (!before || !after) {
+            return false;
+        }
+        changes = VersionedAreaHistory::diff(*before, *after);
+        return true;
+    }
+
+    // Method to list the most recent versions of the registry
+    void displayVersions(size_t maxRows) const {
+        if (!history) {
+            cout << "Version history is not enabled.\n";
+            return;
+        }
+        const deque<RegistryVersion>& versions = history->versions();
+        cout << "\nRegistry versions (" << versions.size() << " kept):\n";
+        ReportTable table({"Version", "Time", "Areas", "Change"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::RIGHT, ReportTable::LEFT});
+        for (size_t i = versions.size(), shown = 0; i > 0 && shown < maxRows; --i, ++shown) {
+            const RegistryVersion& version = versions[i - 1];
+            table.cell(static_cast<long long>(version.number))
+                 .cell(formatTimestamp(version.time))
+                 .cell(static_cast<long long>(version.areas.size()))
+                 .cell(version.change);
+        }
+        table.render(cout);
+    }
+
+    // Method to display the registry as it was at a date given as "YYYY-MM-DD HH:MM:SS"
+    void displayRegistryAt(const string& when, size_t maxRows) const {
+        tm parsed = {};
+        istringstream in(when);
+        in >> get_time(&parsed, "%Y-%m-%d %H:%M:%S");
+        if (in.fail()) {
+            cout << "Invalid date: " << when << "\n";
+            return;
+        }
+        parsed.tm_isdst = -1;
+        const RegistryVersion* version = registryAt(mktime(&parsed));
+        if (!version) {
+            cout << "No kept version of the registry existed at " << when << "\n";
+            return;
+        }
+        vector<shared_ptr<const Area>> areas;
+        version->areas.forEach([&](const shared_ptr<const Area>& area) { areas.push_back(area); });
+        sort(areas.begin(), areas.end(),
+             [](const shared_ptr<const Area>& a, const shared_ptr<const Area>& b) { return a->id < b->id; });
+        cout << "\nRegistry at " << when << " (version " << version->number << ", " << areas.size() << " areas):\n";
+        ReportTable table({"AID", "Area Name", "Waste (t)", "Waste Cat", "Budget Alloc", "Last Updated"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::RIGHT, ReportTable::LEFT,
+                           ReportTable::RIGHT, ReportTable::LEFT});
+        for (size_t i = 0; i < areas.size() && i < maxRows; ++i) {
+            table.cell(areas[i]->id).cell(areas[i]->name).cell(areas[i]->wasteQuantity)
+                 .cell(areas[i]->wasteCategory).cell(areas[i]->budgetAllocated)
+                 .cell(formatTimestamp(areas[i]->lastUpdated));
+        }
+        table.render(cout);
+    }
+
+    // Method to display what changed between two versions of the registry
+    void displayVersionDiff(uint64_t from, uint64_t to, size_t maxRows) const {
+        vector<AreaChange> changes;
+        if (!diffVersions(from, to, changes)) {
+            cout << "Unknown version number (only the newest versions are kept).\n";
+            return;
+        }
+        cout << "\nChanges from version " << from << " to " << to << ": " << changes.size() << " areas\n";
+        ReportTable table({"AID", "Area Name", "Change", "Waste (t)", "Budget Alloc"},
+                          {ReportTable::RIGHT, ReportTable::LEFT, ReportTable::LEFT, ReportTable::LEFT,
+                           ReportTable::LEFT});
+        auto transition = [](const shared_ptr<const Area>& before, const shared_ptr<const Area>& after,
+                             double Area::*field) {
+            ostringstream out;
+            out << fixed << setprecision(2);
+            if (before) {
+                out << (*before).*field;
+            }
+            if (before && after && (*before).*field != (*after).*field) {
+                out << " -> " << (*after).*field;
+            } else if (!before) {
+                out << (*after).*field;
+            }
+            return out.str();
+        };
+        for (size_t i = 0; i < changes.size() && i < maxRows; ++i) {
+            const AreaChange& change = changes[i];
+            const Area& latest = change.after ? *change.after : *change.before;
+            table.cell(latest.id)
+                 .cell(latest.name)
+                 .cell(!change.before ? "Added" : !change.after ? "Removed" : "Modified")
+                 .cell(transition(change.before, change.after, &Area::wasteQuantity))
+                 .cell(transition(change.before, change.after, &Area::budgetAllocated));
+        }
+        table.render(cout);
+    }
+
+    // Method to calculate the total budget across all areas
+    double calculateTotalBudget() const {
+        debugCheckAggregates();
+        return totalBudget.value(); // Maintained on every mutation
+    }
+
+    // Method to calculate the total waste quantity across all areas
+    double calculateTotalWaste() const {
+        debugCheckAggregates();
+        return totalWaste.value();
+    }
+
+    // Method to calculate the total population across all areas
+    long long calculateTotalPopulation() const {
+        debugCheckAggregates();
+        return totalPopulation;
+    }
+
+    // IDs of the 'k' areas with the highest environmental impact, highest first
+    vector<int> topAreasByImpact(size_t k) const {
+        debugCheckAggregates();
+        return impactIndex.top(k);
+    }
+
+    // IDs of the areas whose environmental impact is above 'threshold', highest first
+    vector<int> areasAboveImpact(double threshold) const {
+        debugCheckAggregates();
+        return impactIndex.above(threshold);
+    }
+
+    // IDs of the 'k' densest areas of a waste category, densest first
+    vector<int> topAreasByDensity(const string& category, size_t k) const {
+        Symbol symbol;
+        if (!columns.symbols->find(category, symbol)) {
+            return {};
+        }
+        auto it = densityByCategory.find(symbol);
+        return it == densityByCategory.end() ? vector<int>() : it->second.top(k);
+    }
+
+    // (distance in km, area ID) of the located areas within 'radiusKm' of a point, nearest first
+    vector<pair<double, int>> areasWithinRadius(double latitude, double longitude, double radiusKm) const {
+        return geoIndex.within(latitude, longitude, radiusKm);
+    }
+
+    // (distance in km, area ID) of the 'k' located areas nearest to a point, nearest first
+    vector<pair<double, int>> nearestAreas(double latitude, double longitude, size_t k) const {
+        return geoIndex.nearest(latitude, longitude, k);
+    }
+
+    // Turn the per-read aggregate cross-check on or off
+    void setAggregateChecks(bool enabled) {
+        checkAggregatesOnRead = enabled;
+    }
+
+    // Recompute every aggregate from the columns and compare with the running values
+    bool verifyAggregates() const {
+        double budget = 0, waste = 0;
+        long long population = 0;
+        double highestImpact = -1;
+        for (size_t row = 0; row < columns.size(); ++row) {
+            budget += columns.budgetAllocated[row];
+            waste += columns.wasteQuantity[row];
+            population += columns.population[row];
+            highestImpact = max(highestImpact, rowImpact(row));
+        }
+
+        // Sums may differ from the recompute only by rounding
+        auto close = [](double a, double b) {
+            return fabs(a - b) <= 1e-9 * max(1.0, max(fabs(a), fabs(b)));
+        };
+        double indexedImpact = impactIndex.size() == 0 ? -1 : impactIndex.rbegin()->first;
+        size_t densityEntries = 0;
+        for (const auto& entry : densityByCategory) {
+            densityEntries += entry.second.size();
+        }
+        size_t located = 0;
+        for (size_t row = 0; row < columns.size(); ++row) {
+            located += !std::isnan(columns.latitude[row]) && !std::isnan(columns.longitude[row]);
+        }
+
+        bool budgetMatches = close(budget, totalBudget.value());
+        bool wasteMatches = close(waste, totalWaste.value());
+        bool populationMatches = population == totalPopulation;
+        bool impactIndexComplete = impactIndex.size() == columns.size();
+        bool highestImpactMatches = highestImpact == indexedImpact;
+        bool densityIndexComplete = densityEntries == columns.size();
+        bool geoIndexComplete = located == geoIndex.size();
+        return budgetMatches && wasteMatches && populationMatches && impactIndexComplete && highestImpactMatches &&
+               densityIndexComplete && geoIndexComplete;
+    }
+
+    // Display area with highest environmental impact
+    void displayHighestEnvironmentalImpact() const {
+        cout << "\nArea with highest environmental impact:\n";
+        vector<int> top = topAreasByImpact(1); // Largest entry of the impact index
+        if (top.empty()) {
+            cout << "No areas in the system.\n";
+            return;
+        }
+        displayAreaIds(top);
+    }
+
+    // Display the 'k' areas with the highest environmental impact
+    void displayTopAreasByImpact(size_t k) const {
+        cout << "\nTop " << k << " areas by environmental impact:\n";
+        displayAreaIds(topAreasByImpact(k));
+    }
+
+    // Display the areas whose environmental impact is above a threshold
+    void displayAreasAboveImpact(double threshold) const {
+        cout << "\nAreas with environmental impact above " << threshold << ":\n";
+        displayAreaIds(areasAboveImpact(threshold));
+    }
+
+    // Display the 'k' densest areas of a waste category
+    void displayTopAreasByDensity(const string& category, size_t k) const {
+        cout << "\nTop " << k << " " << category << " areas by waste density:\n";
+        displayAreaIds(topAreasByDensity(category, k));
+    }
+
+    // Display the areas within a radius of a point, e.g. a depot
+    void displayAreasWithinRadius(double latitude, double longitude, double radiusKm) const {
+        cout << "\nAreas within " << radiusKm << " km of (" << latitude << ", " << longitude << "):\n";
+        displayAreaDistances(areasWithinRadius(latitude, longitude, radiusKm));
+    }
+
+    // Display the 'k' areas nearest to a point
+    void displayNearestAreas(double latitude, double longitude, size_t k) const {
+        cout << "\n" << k << " areas nearest to (" << latitude << ", " << longitude << "):\n";
+        displayAreaDistances(nearestAreas(latitude, longitude, k));
+    }
+};
+
+// Self-check of the concurrent read path. One writer ingests batches that set every
+// area to the same waste quantity while reader threads load snapshots and verify
+// that each one is internally consistent: all areas from the same batch, totals
+// matching a recount, and versions never going backwards
+bool runConcurrentRegistryCheck(size_t areaCount, size_t readerCount, double seconds) {
+    Graph g;
+    time_t start = time(0) - 24 * 60 * 60;
+    for (size_t i = 0; i < areaCount; ++i) {
+        g.addArea(static_cast<int>(i), "Area " + to_string(i), 0, i % 2 ? "Plastic" : "Organic", 1.0, "Bel,Kar",
+                  100, start, "Recycling", 50.0, 1000.0);
+    }
+    g.enableConcurrentReads(); // After the bulk load, so it is published once
+
+    atomic<bool> done(false);
+    atomic<size_t> checked(0), failures(0);
+    vector<thread> readers;
+    for (size_t r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&]() {
+            uint64_t lastVersion = 0;
+            while (!done) {
+                shared_ptr<const RegistrySnapshot> snapshot = g.concurrentSnapshot();
+                double batch = -1, waste = 0, budget = 0;
+                long long population = 0;
+                bool ok = snapshot->version() >= lastVersion && snapshot->areaCount() == areaCount;
+                snapshot->forEach([&](const Area& area) {
+                    if (batch < 0) {
+                        batch = area.wasteQuantity;
+                    }
+                    ok = ok && area.wasteQuantity == batch; // A torn read would mix two batches
+                    waste += area.wasteQuantity;
+                    budget += area.budgetAllocated;
+                    population += area.population;
+                });
+                ok = ok && fabs(waste - snapshot->totalWaste()) <= 1e-9 * max(1.0, waste) &&
+                     fabs(budget - snapshot->totalBudget()) <= 1e-9 * max(1.0, budget) &&
+                     population == snapshot->totalPopulation() &&
+                     snapshot->areasByCategory("Plastic").size() == areaCount / 2;
+                if (!ok) {
+                    ++failures;
+                }
+                lastVersion = snapshot->version();
+                ++checked;
+            }
+        });
+    }
+
+    // Writer: every batch moves all areas to the next waste quantity in one publish
+    size_t batches = 0;
+    auto stop = chrono::steady_clock::now() + chrono::duration<double>(seconds);
+    while (chrono::steady_clock::now() < stop) {
+        ++batches;
+        vector<SensorReading> readings;
+        readings.reserve(areaCount);
+        for (size_t i = 0; i < areaCount; ++i) {
+            readings.push_back({static_cast<int>(i), static_cast<double>(batches), start + static_cast<time_t>(batches)});
+        }
+        g.ingestReadings(readings);
+    }
+    done = true;
+    for (thread& reader : readers) {
+        reader.join();
+    }
+
+    cout << "Concurrent registry check: " << batches << " batches published, " << checked << " snapshots verified by "
+         << readerCount << " readers, " << failures << " inconsistent\n";
+    return failures == 0;
+}
+
+// Self-check of durable storage: readings ingested before and after a checkpoint
+// must come back in the same per-area time series after a restart
+bool runDurableHistoryCheck() {
+    const string snapshotFile = "selftest_history.snap", logFile = "selftest_history.wal";
+    remove(snapshotFile.c_str());
+    remove(logFile.c_str());
+    const int AREAS = 200;
+    time_t start = time(0) - 30 * 24 * 60 * 60;
+    size_t mismatched = 0, points = 0;
+    {
+        Graph written;
+        for (int id = 0; id < AREAS; ++id) {
+            written.addArea(id, "Area " + to_string(id), 100, "Plastic", 1.0, "Bel,Kar", 100, start, "Recycling",
+                            50.0, 1000.0);
+        }
+        written.openDurableStore(snapshotFile, logFile);
+        uint32_t seed = 7;
+        for (int batch = 0; batch < 40; ++batch) {
+            vector<SensorReading> readings;
+            for (int i = 0; i < 4 * AREAS; ++i) {
+                seed = seed * 1103515245u + 12345u;
+                readings.push_back({static_cast<int>((seed >> 8) % AREAS), 50 + (seed >> 16) % 500 / 3.0,
+                                    start + batch * 12 * 60 * 60 + static_cast<time_t>((seed >> 4) % 3600)});
+            }
+            written.ingestReadings(readings);
+            if (batch == 25) {
+                written.checkpoint(); // Later readings stay in the log
+            }
+        }
+
+        Graph recovered;
+        recovered.openDurableStore(snapshotFile, logFile);
+        for (int id = 0; id < AREAS; ++id) {
+            auto expected = written.wasteSeries().points(id, 0, numeric_limits<time_t>::max());
+            points += expected.size();
+            bool same = expected == recovered.wasteSeries().points(id, 0, numeric_limits<time_t>::max()) &&
+                        written.wasteSeries().daily(id, 0, numeric_limits<time_t>::max()).size() ==
+                            recovered.wasteSeries().daily(id, 0, numeric_limits<time_t>::max()).size();
+            mismatched += same ? 0 : 1;
+        }
+    }
+    remove(snapshotFile.c_str());
+    remove(logFile.c_str());
+    cout << "Durable history check: " << points << " points in " << AREAS << " areas, " << mismatched
+         << " areas differ after recovery\n";
+    return mismatched == 0;
+}
+
+// Main function to interact with the system and manage areas
+void manageWasteAreas(Graph &g) {
+    g.enableVersionHistory(VERSION_HISTORY_LIMIT, VERSION_HISTORY_MAX_AGE); // Every change below becomes a readable version
+
+    // Recover the areas saved by earlier runs before anything is added
+    if (!g.isDurable()) {
+        g.openDurableStore(DEFAULT_SNAPSHOT_FILE, DEFAULT_LOG_FILE);
+    }
+
+    // Adding areas to the graph for demonstration when neither recovery nor an earlier visit provided any
+    if (g.areaCount() == 0) {
+        g.addArea(1, "Tilakwadi", 1200.0, "Plastic", 8.5, "Bel,Kar", 15000, time(0), "Recycling", 85.0, 50000, 15.8390, 74.5090);
+        g.addArea(2, "Shivaji Nagar", 950.0, "Organic", 6.2, "Bel,Kar", 12000, time(0), "Composting", 75.0, 40000, 15.8625, 74.5205);
+        g.addArea(3, "Camp", 2000.0, "Electronic", 12.0, "Bel,Kar", 18000, time(0), "Disposal", 90.0, 75000, 15.8510, 74.5150);
+        g.addArea(4, "Raviwar Peth", 800.0, "Plastic", 5.5, "Bel,Kar", 10000, time(0), "Recycling", 70.0, 30000, 15.8600, 74.5075);
+        g.addArea(5, "Khanapur Road", 1500.0, "Organic", 10.0, "Bel,Kar", 20000, time(0), "Composting", 80.0, 60000, 15.8300, 74.5060);
+        g.addArea(6, "Maratha Colony", 600.0, "Plastic", 4.8, "Bel,Kar", 8000, time(0), "Recycling", 65.0, 25000, 15.8445, 74.4950);
+        g.addArea(7, "Shahapur", 2200.0, "Electronic", 14.0, "Bel,Kar", 25000, time(0), "Disposal", 95.0, 100000, 15.8480, 74.5045);
+        g.addArea(8, "Angol", 700.0, "Organic", 5.0, "Bel,Kar", 11000, time(0), "Composting", 72.0, 35000, 15.8290, 74.5155);
+        g.addArea(9, "Vivekanand Nagar", 1800.0, "Plastic", 9.0, "Bel,Kar", 17000, time(0), "Recycling", 88.0, 65000, 15.8700, 74.5000);
+        g.addArea(10, "Ramteerth Nagar", 2500.0, "Electronic", 15.0, "Bel,Kar", 30000, time(0), "Disposal", 92.0, 125000, 15.8785, 74.5320);
+    }
+
+
+    int choice;
+    do {
+        // Display menu for user to choose operations
+        cout << "\nMenu:\n";
+        cout << "1. Display all areas\n";
+        cout << "2. Display top areas by waste quantity\n";
+        cout << "3. Display areas by waste category\n";
+        cout << "4. Update area data\n";
+        cout << "5. Delete area\n";
+        cout << "6. Export data to CSV file\n";
+        cout << "7. Import data from CSV file\n";
+        cout << "8. Calculate total budget, waste and population\n";
+        cout << "9. Display area with highest environmental impact\n";
+        cout << "10. Exit\n";
+        cout << "11. Save binary snapshot\n";
+        cout << "12. Load binary snapshot\n";
+        cout << "13. Display areas by waste management strategy\n";
+        cout << "14. Display areas by location\n";
+        cout << "15. Display areas by waste quantity range\n";
+        cout << "16. Ingest sensor readings from file\n";
+        cout << "17. Display daily waste history of an area\n";
+        cout << "18. Display per-area metrics\n";
+        cout << "19. Display a page of areas\n";
+        cout << "20. Enable durable storage (snapshot + write-ahead log)\n";
+        cout << "21. Checkpoint write-ahead log\n";
+        cout << "22. Display top N areas by environmental impact\n";
+        cout << "23. Display areas above an environmental impact\n";
+        cout << "24. Display top N areas by waste density in a category\n";
+        cout << "25. Display areas within a radius of a point\n";
+        cout << "26. Display areas nearest to a point\n";
+        cout << "27. Optimize budget allocation\n";
+        cout << "28. Forecast waste generation\n";
+        cout << "29. Display anomaly alerts\n";
+        cout << "30. Export columnar file for analytics\n";
+        cout << "31. Read columns from a columnar file\n";
+        cout << "32. List registry versions\n";
+        cout << "33. Show registry as of a date\n";
+        cout << "34. Compare two registry versions\n";
+        cout << "Enter your choice: ";
+        cin >> choice;
+
+        // Switch case to handle the user's choice
+        switch (choice) {
+            case 1:
+                g.displayAreas(); // Display all areas
+                break;
+            case 2: {
+                size_t count;
+                cout << "Enter number of areas to display: ";
+                cin >> count; // Get how many areas to show
+                g.displayTopAreasByWaste(count); // Read the top areas from the waste quantity index
+                break;
+            }
+            case 3: {
+                string category;
+                cout << "Enter waste category: ";
+                cin.ignore();
+                getline(cin, category); // Get waste category from user
+                g.displayAreasByCategory(category); // Display areas by waste category
+                break;
+            }
+            case 4: {
+                int id;
+                cout << "Enter area ID to update: ";
+                cin >> id; // Get area ID to update from user
+                g.updateAreaData(id); // Update area data
+                break;
+            }
+            case 5: {
+                int id;
+                cout << "Enter area ID to delete: ";
+                cin >> id; // Get area ID to delete from user
+                g.deleteArea(id); // Delete area by ID
+                break;
+            }
+            case 6: {
+                string filename;
+                cout << "Enter filename to save data: ";
+                cin >> filename; // Get filename to save data
+                g.saveToFile(filename); // Save data to file
+                break;
+            }
+            case 7: {
+                string filename;
+                cout << "Enter filename to load data: ";
+                cin >> filename; // Get filename to load data
+                g.loadFromFile(filename); // Load data from file
+                break;
+            }
+            case 8: {
+                double totalBudget = g.calculateTotalBudget(); // Calculate the total budget
+                cout << "Total budget allocated across all areas: " << totalBudget << endl;
+                cout << "Total waste across all areas: " << g.calculateTotalWaste() << " tons" << endl;
+                cout << "Total population across all areas: " << g.calculateTotalPopulation() << endl;
+                break;
+            }
+            case 9:
+                g.displayHighestEnvironmentalImpact(); // Display area with highest environmental impact
+                break;
+            case 10:
+                g.flushLog(); // Nothing logged is left waiting for the group deadline
+                cout << "Exiting program...\n"; // Exit the program
+                break;
+            case 11: {
+                string filename;
+                cout << "Enter filename to save snapshot: ";
+                cin >> filename; // Get snapshot filename
+                g.saveSnapshot(filename); // Write the binary snapshot
+                break;
+            }
+            case 12: {
+                string filename;
+                cout << "Enter filename to load snapshot: ";
+                cin >> filename; // Get snapshot filename
+                g.loadSnapshot(filename); // Replace the registry with the snapshot
+                break;
+            }
+            case 13: {
+                string strategy;
+                cout << "Enter waste management strategy: ";
+                cin.ignore();
+                getline(cin, strategy); // Get strategy from user
+                g.displayAreasByStrategy(strategy); // Display areas using the strategy
+                break;
+            }
+            case 14: {
+                string location;
+                cout << "Enter location: ";
+                cin.ignore();
+                getline(cin, location); // Get location from user
+                g.displayAreasByLocation(location); // Display areas in the location
+                break;
+            }
+            case 15: {
+                double low, high;
+                cout << "Enter minimum and maximum waste quantity: ";
+                cin >> low >> high; // Get the range from user
+                g.displayAreasByWasteRange(low, high); // Range query on the waste quantity index
+                break;
+            }
+            case 16: {
+                string filename;
+                cout << "Enter filename with readings (areaId,wasteQuantity,timestamp): ";
+                cin >> filename; // Get readings filename
+                vector<SensorReading> readings;
+                size_t malformed = loadSensorReadings(filename, readings);
+                if (malformed > 0) {
+                    cout << "Skipped " << malformed << " malformed lines.\n";
+                }
+                g.ingestReadings(readings).display(); // Apply the batch and show its counters
+                cout << "\nTotals since start:\n";
+                g.ingestCounters().display();
+                break;
+            }
+            case 17: {
+                int id, days;
+                cout << "Enter area ID and number of days: ";
+                cin >> id >> days; // Get area and history length
+                g.displayDailyWasteHistory(id, days); // Read the daily rollups of the area
+                break;
+            }
+            case 18:
+                g.displayAreaMetrics(); // Batch-compute density, impact and per-capita waste
+                break;
+            case 19: {
+                size_t page, pageSize;
+                cout << "Enter page number and page size: ";
+                cin >> page >> pageSize; // Get the page to display
+                if (page < 1 || pageSize < 1) {
+                    cout << "Page number and page size must be at least 1.\n";
+                    break;
+                }
+                g.displayAreas((page - 1) * pageSize, pageSize); // Display one page of the sorted table
+                break;
+            }
+            case 20: {
+                string snapshotFile, logFile;
+                cout << "Enter snapshot filename and log filename: ";
+                cin >> snapshotFile >> logFile; // Get the durable store files
+                g.openDurableStore(snapshotFile, logFile); // Recover from them, then log every change
+                break;
+            }
+            case 21:
+                if (g.checkpoint()) { // Compact the log into the snapshot
+                    cout << "Checkpoint written.\n";
+                }
+                break;
+            case 22: {
+                size_t count;
+                cout << "Enter number of areas to display: ";
+                cin >> count; // Get how many areas to show
+                g.displayTopAreasByImpact(count); // Read the top areas from the impact index
+                break;
+            }
+            case 23: {
+                double threshold;
+                cout << "Enter environmental impact threshold: ";
+                cin >> threshold; // Get the impact threshold
+                g.displayAreasAboveImpact(threshold);
+                break;
+            }
+            case 24: {
+                string category;
+                size_t count;
+                cout << "Enter waste category: ";
+                cin.ignore();
+                getline(cin, category); // Get waste category from user
+                cout << "Enter number of areas to display: ";
+                cin >> count; // Get how many areas to show
+                g.displayTopAreasByDensity(category, count); // Read the category's density index
+                break;
+            }
+            case 25: {
+                double latitude, longitude, radius;
+                cout << "Enter latitude, longitude and radius (km): ";
+                cin >> latitude >> longitude >> radius; // Get the point and search radius
+                g.displayAreasWithinRadius(latitude, longitude, radius); // Query the spatial index
+                break;
+            }
+            case 26: {
+                double latitude, longitude;
+                size_t count;
+                cout << "Enter latitude, longitude and number of areas: ";
+                cin >> latitude >> longitude >> count; // Get the point and how many areas to show
+                g.displayNearestAreas(latitude, longitude, count); // Query the spatial index
+                break;
+            }
+            case 27: {
+                double totalBudget;
+                int capCount;
+                BudgetPlanOptions options;
+                cout << "Enter total budget, minimum budget per area and cost per ton: ";
+                cin >> totalBudget >> options.defaultMinimum >> options.costPerTon; // Get the model settings
+                cout << "Enter number of capped waste categories: ";
+                cin >> capCount;
+                for (int i = 0; i < capCount; ++i) {
+                    string category;
+                    double cap;
+                    cout << "Enter waste category: ";
+                    cin.ignore();
+                    getline(cin, category); // Get the capped category
+                    cout << "Enter budget cap for " << category << ": ";
+                    cin >> cap;
+                    options.categoryCap[category] = cap;
+                }
+                BudgetPlan plan = g.optimizeBudget(totalBudget, options); // Solve for the best allocation
+                g.displayBudgetPlan(plan, 20);
+                if (plan.error.empty()) {
+                    char answer;
+                    cout << "Apply this allocation? (y/n): ";
+                    cin >> answer;
+                    if (answer == 'y' || answer == 'Y') {
+                        cout << g.applyBudgetPlan(plan) << " area budgets updated.\n";
+                    }
+                }
+                break;
+            }
+            case 28:
+                g.displayWasteForecasts(20); // Refit every area and show the largest forecasts
+                break;
+            case 29:
+                g.checkStaleAreas(); // Raise alerts for areas without recent readings
+                g.displayRecentAlerts(20);
+                break;
+            case 30: {
+                string filename;
+                cout << "Enter filename to export to: ";
+                cin >> filename; // Get columnar filename
+                g.saveColumnar(filename); // Write typed, encoded column chunks
+                break;
+            }
+            case 31: {
+                string filename, line, name;
+                cout << "Enter columnar filename: ";
+                cin >> filename; // Get columnar filename
+                cout << "Enter column names separated by spaces: ";
+                cin.ignore();
+                getline(cin, line); // Get the columns to read
+                vector<string> names;
+                istringstream stream(line);
+                while (stream >> name) {
+                    names.push_back(name);
+                }
+                displayColumnarColumns(filename, names, 20); // Decode only those columns
+                break;
+            }
+            case 32:
+                g.displayVersions(20);
+                break;
+            case 33: {
+                string when;
+                cout << "Enter date and time (YYYY-MM-DD HH:MM:SS): ";
+                cin.ignore();
+                getline(cin, when); // Get the point in time
+                g.displayRegistryAt(when, 20);
+                break;
+            }
+            case 34: {
+                uint64_t from, to;
+                cout << "Enter the two version numbers: ";
+                cin >> from >> to;
+                g.displayVersionDiff(from, to, 20);
+                break;
+            }
+            default:
+                cout << "Invalid option! Try again.\n"; // Handle invalid option
+                break;
+        }
+
+    } while (choice != 10); // Continue until user chooses to exit
+}
+
+
+//module2
+
+#include <iostream>
+#include <vector>
+#include <climits>
+#include <queue>
 
-    void saveToFile(const string& filename) const {
+using namespace std;
 
-        ofstream outFile(filename); // Open file for writing
+// A road between two areas, as given when building a road network
+struct Road {
+    int from;
+    int to;
+    int distance;
+};
 
-        if (outFile.is_open()) {
+// Road network stored in compressed sparse row form: the roads leaving area u are
+// targets[offsets[u]] .. targets[offsets[u + 1] - 1] with matching weights, so a
+// network of any size is three contiguous arrays plus the area names. A second
+// CSR lists the roads entering each area, and any road can be closed and reopened
+class RoadNetwork {
+private:
+    vector<string> names;
+    vector<size_t> offsets{0};
+    vector<int> targets;
+    vector<int> weights;
+    vector<char> closed;          // Per road: 1 while the road is closed
+    vector<size_t> inOffsets{0};  // Roads entering area v: inRoads[inOffsets[v]] .. inRoads[inOffsets[v + 1] - 1]
+    vector<size_t> inRoads;
+
+public:
+    // Function to give the longest road distance a network of 'areaCount' areas
+    // accepts. A route visits each area at most once, so every route length, and
+    // the sum of two of them (A* estimates, bidirectional searches), fits in an int
+    static int maxRoadDistance(size_t areaCount) {
+        return static_cast<int>(INT_MAX / 2 / max<size_t>(areaCount, 1));
+    }
+
+    // Function to build the network from area names and one-way roads. Roads keep
+    // their given order within each area; roads with unknown areas or a distance
+    // outside 0 .. maxRoadDistance() are rejected
+    bool build(const vector<string>& areaNames, const vector<Road>& roads) {
+        if (areaNames.size() > static_cast<size_t>(INT_MAX)) {
+            return false;
+        }
+        int n = static_cast<int>(areaNames.size());
+        int maxDistance = maxRoadDistance(areaNames.size());
+        for (const Road& road : roads) {
+            if (road.from < 0 || road.from >= n || road.to < 0 || road.to >= n || road.distance < 0 ||
+                road.distance > maxDistance) {
+                return false;
+            }
+        }
+        names = areaNames;
+        offsets.assign(n + 1, 0);
+        for (const Road& road : roads) {
+            ++offsets[road.from + 1];
+        }
+        for (int u = 0; u < n; ++u) {
+            offsets[u + 1] += offsets[u];
+        }
+        targets.assign(roads.size(), 0);
+        weights.assign(roads.size(), 0);
+        vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        for (const Road& road : roads) {
+            size_t e = next[road.from]++;
+            targets[e] = road.to;
+            weights[e] = road.distance;
+        }
+        closed.assign(roads.size(), 0);
+
+        inOffsets.assign(n + 1, 0);
+        for (int v : targets) {
+            ++inOffsets[v + 1];
+        }
+        for (int v = 0; v < n; ++v) {
+            inOffsets[v + 1] += inOffsets[v];
+        }
+        inRoads.assign(roads.size(), 0);
+        next.assign(inOffsets.begin(), inOffsets.end() - 1);
+        for (size_t e = 0; e < targets.size(); ++e) {
+            inRoads[next[targets[e]]++] = e;
+        }
+        return true;
+    }
 
-            // Loop through all areas and write their data to the file
+    // Function to load a network from a text file: a line with the area and road
+    // counts, one line per area name, then one "from to distance" line per road
+    bool loadFromFile(const string& filename, string& error) {
+        ifstream file(filename);
+        if (!file) {
+            error = "cannot open file";
+            return false;
+        }
+        size_t areaCount = 0, roadCount = 0;
+        if (!(file >> areaCount >> roadCount)) {
+            error = "missing area and road counts";
+            return false;
+        }
+        if (areaCount > static_cast<size_t>(INT_MAX)) {
+            error = "too many areas";
+            return false;
+        }
+        file.ignore(numeric_limits<streamsize>::max(), '\n');
+        // The vectors grow as lines are read, so a corrupt header cannot demand a
+        // huge allocation up front
+        const size_t RESERVE_LIMIT = 1 << 20;
+        vector<string> areaNames;
+        areaNames.reserve(min(areaCount, RESERVE_LIMIT));
+        string areaName;
+        while (areaNames.size() < areaCount && getline(file, areaName)) {
+            areaNames.push_back(areaName);
+        }
+        if (areaNames.size() < areaCount) {
+            error = "expected " + to_string(areaCount) + " area names";
+            return false;
+        }
+        vector<Road> roads;
+        roads.reserve(min(roadCount, RESERVE_LIMIT));
+        Road road;
+        while (roads.size() < roadCount && file >> road.from >> road.to >> road.distance) {
+            roads.push_back(road);
+        }
+        if (roads.size() < roadCount) {
+            error = "expected " + to_string(roadCount) + " roads, read " + to_string(roads.size());
+            return false;
+        }
+        if (!build(areaNames, roads)) {
+            error = "road with an unknown area or a distance outside 0.." +
+                    to_string(maxRoadDistance(areaNames.size()));
+            return false;
+        }
+        return true;
+    }
 
-            for (const auto& entry : nodes) {
+    int areaCount() const {
+        return static_cast<int>(names.size());
+    }
 
-                const Area& area = entry.second;
+    size_t roadCount() const {
+        return targets.size();
+    }
 
-                outFile << area.id << ","
+    const string& name(int area) const {
+        return names[area];
+    }
 
-                        << area.name << ","
+    // Range of road indices leaving 'area'
+    size_t roadsBegin(int area) const {
+        return offsets[area];
+    }
 
+    size_t roadsEnd(int area) const {
+        return offsets[area + 1];
+    }
 
-                        << area.wasteQuantity << ","
+    int target(size_t road) const {
+        return targets[road];
+    }
 
+    int weight(size_t road) const {
+        return weights[road];
+    }
 
-                        << area.wasteCategory << ","
+    // Area a road leaves from
+    int source(size_t road) const {
+        return static_cast<int>(upper_bound(offsets.begin(), offsets.end(), road) - offsets.begin()) - 1;
+    }
 
-                        << area.areaSize << ","
+    // Range of positions in the incoming road list of 'area'; incomingRoad() maps
+    // a position to the road index
+    size_t incomingBegin(int area) const {
+        return inOffsets[area];
+    }
 
-                        << area.location << ","
+    size_t incomingEnd(int area) const {
+        return inOffsets[area + 1];
+    }
 
+    size_t incomingRoad(size_t position) const {
+        return inRoads[position];
+    }
 
+    bool isOpen(size_t road) const {
+        return !closed[road];
+    }
 
-                        << area.wasteManagementStrategy << ","
+    // Function to change the distance of one road; distances outside
+    // 0 .. maxRoadDistance() are rejected
+    bool setWeight(size_t road, int distance) {
+        if (distance < 0 || distance > maxRoadDistance(names.size())) {
+            return false;
+        }
+        weights[road] = distance;
+        return true;
+    }
 
-                         << area.population << ","
+    // Index of the first road from 'u' to 'v', or SIZE_MAX if there is none
+    size_t findRoad(int u, int v) const {
+        for (size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+            if (targets[e] == v) {
+                return e;
+            }
+        }
+        return SIZE_MAX;
+    }
 
-                        << area.environmentalImpactScore << ","
+    // Function to close every open road between 'u' and 'v', in both directions.
+    // Returns the indices of the roads that were closed
+    vector<size_t> closeRoad(int u, int v) {
+        return setClosed(u, v, true);
+    }
 
-                        << area.budgetAllocated << ","
+    // Function to reopen every closed road between 'u' and 'v', in both directions
+    vector<size_t> reopenRoad(int u, int v) {
+        return setClosed(u, v, false);
+    }
 
-                        << ctime(&area.lastUpdated) << "\n"; // Use ctime for readable time format
+private:
+    vector<size_t> setClosed(int u, int v, bool close) {
+        vector<size_t> changed;
+        for (int from : {u, v}) {
+            int to = from == u ? v : u;
+            for (size_t e = offsets[from]; e < offsets[from + 1]; ++e) {
+                if (targets[e] == to && closed[e] != close) {
+                    closed[e] = close;
+                    changed.push_back(e);
+                }
             }
-            cout << "Data saved to " << filename << endl;
+            if (u == v) {
+                break;
+            }
+        }
+        return changed;
+    }
+};
+
+// Road network of the simulated city
+RoadNetwork roadNetwork;
+
+// Truck capacity (in units of waste)
+const int TRUCK_CAPACITY = 100;
+
+// Function to find shortest distances from 'start' over the open roads of 'network'
+void shortestDistances(const RoadNetwork& network, int start, vector<int>& dist) {
+    dist.assign(network.areaCount(), INT_MAX);
+    dist[start] = 0;
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+    pq.push({0, start});
+
+    while (!pq.empty()) {
+        int u = pq.top().second;
+        int d = pq.top().first;
+        pq.pop();
+
+        if (d > dist[u]) continue;
+
+        for (size_t e = network.roadsBegin(u), end = network.roadsEnd(u); e < end; ++e) {
+            if (!network.isOpen(e)) continue;
+            int v = network.target(e);
+            int weight = network.weight(e);
+
+            if (dist[u] + weight < dist[v]) {
+                dist[v] = dist[u] + weight;
+                pq.push({dist[v], v});
+            }
+        }
+    }
+}
+
+// Function to find shortest paths using Dijkstra's Algorithm
+void dijkstra(int start, vector<int>& dist) {
+    shortestDistances(roadNetwork, start, dist);
+}
+
+// Shortest-path trees from recently used start areas, kept correct as roads close
+// and reopen. Closing a road only recomputes the areas whose shortest path used
+// it (the subtree below the road); reopening a road only propagates from its end
+// as far as distances improve. Every other area keeps its distance untouched
+class ShortestPathCache {
+private:
+    static constexpr size_t NO_ROAD = SIZE_MAX;
+    static const size_t MAX_TREES = 32; // Oldest tree is dropped beyond this
+
+    struct Tree {
+        vector<int> dist;
+        vector<size_t> parent; // Road into each area on its shortest path
+    };
+
+    const RoadNetwork& network;
+    unordered_map<int, Tree> trees;
+    deque<int> order;              // Start areas, oldest first
+    vector<char> inSubtree;        // Scratch marks, all zero between repairs
+    size_t areasRecomputed = 0;
+
+    typedef priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> Queue;
+
+    // Settle the queued areas, relaxing open roads like dijkstra()
+    void propagate(Tree& tree, Queue& pq) {
+        while (!pq.empty()) {
+            int u = pq.top().second;
+            int d = pq.top().first;
+            pq.pop();
+
+            if (d > tree.dist[u]) continue;
+
+            for (size_t e = network.roadsBegin(u), end = network.roadsEnd(u); e < end; ++e) {
+                if (!network.isOpen(e)) continue;
+                int v = network.target(e);
+                if (d + network.weight(e) < tree.dist[v]) {
+                    tree.dist[v] = d + network.weight(e);
+                    tree.parent[v] = e;
+                    pq.push({tree.dist[v], v});
+                }
+            }
+        }
+    }
+
+    void build(int start, Tree& tree) {
+        tree.dist.assign(network.areaCount(), INT_MAX);
+        tree.parent.assign(network.areaCount(), NO_ROAD);
+        tree.dist[start] = 0;
+        Queue pq;
+        pq.push({0, start});
+        propagate(tree, pq);
+    }
+
+    // Repair a tree after 'road' was closed or made longer
+    void repairClosed(Tree& tree, size_t road) {
+        int v = network.target(road);
+        if (tree.parent[v] != road) {
+            return; // The road was not on any shortest path of this tree
+        }
+
+        // Collect the subtree hanging below the road: its areas lose their distances
+        vector<int> subtree{v};
+        inSubtree[v] = 1;
+        for (size_t i = 0; i < subtree.size(); ++i) {
+            int u = subtree[i];
+            for (size_t e = network.roadsBegin(u), end = network.roadsEnd(u); e < end; ++e) {
+                int w = network.target(e);
+                if (tree.parent[w] == e && !inSubtree[w]) {
+                    inSubtree[w] = 1;
+                    subtree.push_back(w);
+                }
+            }
+        }
+        for (int u : subtree) {
+            tree.dist[u] = INT_MAX;
+            tree.parent[u] = NO_ROAD;
+        }
+
+        // Seed each subtree area with its best open road from outside the subtree,
+        // whose distances are unchanged, then settle the subtree
+        Queue pq;
+        for (int u : subtree) {
+            for (size_t p = network.incomingBegin(u), end = network.incomingEnd(u); p < end; ++p) {
+                size_t e = network.incomingRoad(p);
+                int from = network.source(e);
+                if (!network.isOpen(e) || inSubtree[from] || tree.dist[from] == INT_MAX) continue;
+                if (tree.dist[from] + network.weight(e) < tree.dist[u]) {
+                    tree.dist[u] = tree.dist[from] + network.weight(e);
+                    tree.parent[u] = e;
+                }
+            }
+            if (tree.dist[u] != INT_MAX) {
+                pq.push({tree.dist[u], u});
+            }
+        }
+        for (int u : subtree) {
+            inSubtree[u] = 0;
+        }
+        propagate(tree, pq);
+        areasRecomputed += subtree.size();
+    }
+
+    // Repair a tree after 'road' was reopened or made shorter
+    void repairOpened(Tree& tree, size_t road) {
+        int u = network.source(road), v = network.target(road);
+        if (tree.dist[u] == INT_MAX || tree.dist[u] + network.weight(road) >= tree.dist[v]) {
+            return; // The road gives no shorter path
+        }
+        tree.dist[v] = tree.dist[u] + network.weight(road);
+        tree.parent[v] = road;
+        Queue pq;
+        pq.push({tree.dist[v], v});
+        propagate(tree, pq);
+    }
+
+public:
+    explicit ShortestPathCache(const RoadNetwork& roads) : network(roads) {}
+
+    // Shortest distances from 'start' (INT_MAX if not accessible), from the cache
+    // when possible
+    const vector<int>& distances(int start) {
+        auto it = trees.find(start);
+        if (it == trees.end()) {
+            if (trees.size() >= MAX_TREES) {
+                trees.erase(order.front());
+                order.pop_front();
+            }
+            it = trees.emplace(start, Tree()).first;
+            order.push_back(start);
+            build(start, it->second);
+        }
+        return it->second.dist;
+    }
+
+    // Function to update every cached tree after roads were closed
+    void roadsClosed(const vector<size_t>& roads) {
+        inSubtree.resize(network.areaCount(), 0);
+        for (size_t road : roads) {
+            for (auto& entry : trees) {
+                repairClosed(entry.second, road);
+            }
+        }
+    }
+
+    // Function to update every cached tree after roads were reopened
+    void roadsOpened(const vector<size_t>& roads) {
+        for (size_t road : roads) {
+            for (auto& entry : trees) {
+                repairOpened(entry.second, road);
+            }
+        }
+    }
+
+    // Function to update every cached tree after the distance of a road changed
+    void roadWeightChanged(size_t road, int oldWeight) {
+        if (!network.isOpen(road)) {
+            return; // Closed roads are on no shortest path
+        }
+        inSubtree.resize(network.areaCount(), 0);
+        for (auto& entry : trees) {
+            if (network.weight(road) > oldWeight) {
+                repairClosed(entry.second, road);
+            } else if (network.weight(road) < oldWeight) {
+                repairOpened(entry.second, road);
+            }
+        }
+    }
+
+    // Function to drop every tree, e.g. after a different network was loaded
+    void clear() {
+        trees.clear();
+        order.clear();
+        inSubtree.clear();
+    }
+
+    size_t cachedTrees() const {
+        return trees.size();
+    }
+
+    // Total areas whose distance was recomputed by closures so far
+    size_t recomputedAreas() const {
+        return areasRecomputed;
+    }
+};
+
+// Shortest paths from the depots and start areas used so far
+ShortestPathCache routeCache(roadNetwork);
+
+// Distances between a stable set of source areas (depots, transfer stations,
+// collection points) and every area, as one row-major matrix: row r holds the
+// distances from sources[r], so any lookup is a single array access. Rows are
+// computed in parallel, one Dijkstra per source. When a road changes, only the
+// rows whose shortest paths it can affect are marked stale, and a stale row is
+// recomputed the next time it is read
+class DistanceMatrix {
+private:
+    const RoadNetwork* network = nullptr;
+    vector<int> sources;   // Area of each row
+    vector<int> rowOf;     // Row of each area, -1 if the area is not a source
+    vector<int> cells;     // sources.size() x areaCount distances, INT_MAX if not accessible
+    vector<char> stale;    // Rows to recompute before their next lookup
+    size_t refreshed = 0;
+
+    int* rowData(size_t row) {
+        return cells.data() + row * network->areaCount();
+    }
+
+    void computeRow(size_t row) {
+        vector<int> dist;
+        shortestDistances(*network, sources[row], dist);
+        copy(dist.begin(), dist.end(), rowData(row));
+        stale[row] = 0;
+    }
+
+    // Mark the rows a road change can affect; a cost of INT_MAX means closed
+    void roadCostChanged(size_t road, int oldCost, int newCost) {
+        if (oldCost == newCost) {
+            return;
+        }
+        int u = network->source(road), v = network->target(road);
+        size_t n = network->areaCount();
+        for (size_t row = 0; row < sources.size(); ++row) {
+            const int* dist = cells.data() + row * n;
+            if (stale[row] || dist[u] == INT_MAX) {
+                continue;
+            }
+            if (newCost > oldCost) {
+                stale[row] = dist[u] + oldCost == dist[v]; // Road may be on a shortest path
+            } else {
+                stale[row] = dist[u] + newCost < dist[v];  // Road now gives a shorter path
+            }
+        }
+    }
+
+    // Predecessor of 'v' on a shortest path that is strictly closer to the start,
+    // -1 if 'v' is only reached over zero-distance roads. Among several, the one
+    // with the smallest (distance, area), which Dijkstra settles first
+    int closerPredecessor(const int* dist, int v) const {
+        int best = -1;
+        for (size_t p = network->incomingBegin(v), end = network->incomingEnd(v); p < end; ++p) {
+            size_t e = network->incomingRoad(p);
+            int u = network->source(e);
+            if (!network->isOpen(e) || dist[u] == INT_MAX || dist[u] >= dist[v] ||
+                dist[u] + network->weight(e) != dist[v]) continue;
+            if (best == -1 || make_pair(dist[u], u) < make_pair(dist[best], best)) {
+                best = u;
+            }
+        }
+        return best;
+    }
+
+    // Areas from 'v' back over zero-distance roads to the nearest area that is the
+    // start or has a closer predecessor (breadth-first, so zero-distance cycles
+    // cannot trap the walk). Excludes 'v'
+    vector<int> zeroDistanceLeg(int from, const int* dist, int v) const {
+        unordered_map<int, int> next{{v, -1}}; // Area -> the area after it towards 'v'
+        deque<int> queue{v};
+        while (!queue.empty()) {
+            int x = queue.front();
+            queue.pop_front();
+            if (x != v && (x == from || closerPredecessor(dist, x) != -1)) {
+                vector<int> leg;
+                for (int a = x; a != v; a = next[a]) {
+                    leg.push_back(a);
+                }
+                reverse(leg.begin(), leg.end());
+                return leg;
+            }
+            for (size_t p = network->incomingBegin(x), end = network->incomingEnd(x); p < end; ++p) {
+                size_t e = network->incomingRoad(p);
+                int u = network->source(e);
+                if (network->isOpen(e) && network->weight(e) == 0 && dist[u] == dist[x] && next.emplace(u, x).second) {
+                    queue.push_back(u);
+                }
+            }
+        }
+        return {}; // Unreachable while the row is up to date
+    }
+
+public:
+    // Function to compute the rows for 'sourceAreas' over 'roads', in parallel
+    void build(const RoadNetwork& roads, const vector<int>& sourceAreas) {
+        network = &roads;
+        sources = sourceAreas;
+        rowOf.assign(roads.areaCount(), -1);
+        for (size_t row = 0; row < sources.size(); ++row) {
+            rowOf[sources[row]] = static_cast<int>(row);
+        }
+        cells.assign(sources.size() * roads.areaCount(), INT_MAX);
+        stale.assign(sources.size(), 1);
+        runParallel(sources.size(), [&](size_t row) { computeRow(row); });
+    }
+
+    bool hasSource(int area) const {
+        return network && area >= 0 && area < network->areaCount() && rowOf[area] >= 0;
+    }
+
+    // Distances from source area 'from' to every area, refreshed if stale
+    const int* row(int from) {
+        size_t r = rowOf[from];
+        if (stale[r]) {
+            computeRow(r);
+            ++refreshed;
+        }
+        return rowData(r);
+    }
+
+    // Distance between a source area and any area, INT_MAX if not accessible
+    int distance(int from, int to) {
+        return row(from)[to];
+    }
+
+    // Areas on a shortest path from source 'from' to 'to', empty if not accessible.
+    // Each step goes back to the closer predecessor with the smallest (distance,
+    // area), the one Dijkstra settles first, so ties resolve the same way Dijkstra
+    // does; stretches of zero-distance roads are crossed breadth-first
+    vector<int> route(int from, int to) {
+        const int* dist = row(from);
+        if (dist[to] == INT_MAX) {
+            return {};
+        }
+        vector<int> path{to};
+        for (int v = to; v != from;) {
+            int best = closerPredecessor(dist, v);
+            if (best != -1) {
+                v = best;
+                path.push_back(v);
+                continue;
+            }
+            vector<int> leg = zeroDistanceLeg(from, dist, v);
+            if (leg.empty()) {
+                return {};
+            }
+            path.insert(path.end(), leg.begin(), leg.end());
+            v = leg.back();
+        }
+        reverse(path.begin(), path.end());
+        return path;
+    }
+
+    // Function to mark the rows affected by closed roads as stale
+    void roadsClosed(const vector<size_t>& roads) {
+        for (size_t road : roads) {
+            roadCostChanged(road, network->weight(road), INT_MAX);
+        }
+    }
+
+    // Function to mark the rows affected by reopened roads as stale
+    void roadsOpened(const vector<size_t>& roads) {
+        for (size_t road : roads) {
+            roadCostChanged(road, INT_MAX, network->weight(road));
+        }
+    }
+
+    // Function to mark the rows affected by a road whose distance was 'oldWeight'
+    void roadWeightChanged(size_t road, int oldWeight) {
+        if (network->isOpen(road)) {
+            roadCostChanged(road, oldWeight, network->weight(road));
+        }
+    }
+
+    size_t sourceCount() const {
+        return sources.size();
+    }
+
+    size_t staleRows() const {
+        return count(stale.begin(), stale.end(), 1);
+    }
+
+    // Rows recomputed lazily since the matrix was built
+    size_t refreshedRows() const {
+        return refreshed;
+    }
+};
+
+// Function to check that every DistanceMatrix route is a shortest path, on the
+// smallest zero-distance cycle (5 -> 1 -> 2 -> 1) and on random networks where
+// many roads have distance 0. Returns true if every route is valid
+bool runDistanceMatrixCheck() {
+    uint32_t seed = 12345;
+    auto random = [&seed](uint32_t range) {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int>((seed >> 16) % range);
+    };
+    size_t routes = 0, failures = 0;
+    for (int trial = 0; trial <= 200; ++trial) {
+        int n = trial == 0 ? 6 : 2 + random(30);
+        vector<Road> roads;
+        if (trial == 0) {
+            roads = {{5, 1, 0}, {1, 2, 0}, {2, 1, 0}};
         } else {
-            cout << "Error saving data to file.\n";
+            for (int r = random(4 * n); r > 0; --r) {
+                roads.push_back({random(n), random(n), random(3) == 0 ? random(10) : 0});
+            }
+        }
+        RoadNetwork network;
+        network.build(vector<string>(n, "Area"), roads);
+        vector<int> sources;
+        for (int area = 0; area < n; ++area) {
+            sources.push_back(area);
+        }
+        DistanceMatrix matrix;
+        matrix.build(network, sources);
+        for (int from = 0; from < n; ++from) {
+            for (int to = 0; to < n; ++to) {
+                int expected = matrix.distance(from, to);
+                vector<int> path = matrix.route(from, to);
+                bool ok = expected == INT_MAX ? path.empty()
+                                              : !path.empty() && path.front() == from && path.back() == to;
+                int length = 0;
+                for (size_t i = 0; ok && i + 1 < path.size(); ++i) {
+                    int step = INT_MAX;
+                    for (size_t e = network.roadsBegin(path[i]); e < network.roadsEnd(path[i]); ++e) {
+                        if (network.target(e) == path[i + 1]) {
+                            step = min(step, network.weight(e));
+                        }
+                    }
+                    ok = step != INT_MAX;
+                    length += ok ? step : 0;
+                }
+                ok = ok && (expected == INT_MAX || length == expected);
+                ++routes;
+                failures += ok ? 0 : 1;
+            }
+        }
+    }
+    cout << "Distance matrix route check: " << routes << " routes, " << failures << " invalid\n";
+    return failures == 0;
+}
+
+// Contraction Hierarchies for point-to-point queries on a static road network
+//
+// Preprocessing contracts the areas one by one, least important first. When an
+// area is removed, a shortcut u -> w replaces each path u -> v -> w that is the
+// only shortest connection between u and w (checked by a small local "witness"
+// search). A query then runs two Dijkstra searches that only climb to more
+// important areas, forward from the start and backward from the target, and
+// settles a tiny part of the network. Each shortcut remembers the two roads it
+// replaces, so a path is unpacked back into the original areas
+class ContractionHierarchy {
+private:
+    struct Edge {
+        int from;
+        int to;
+        int weight;
+        int first;   // For shortcuts: the two edges it replaces, otherwise -1
+        int second;
+    };
+
+    vector<Edge> edges;
+    vector<int> rank;             // Contraction order of each area
+    vector<size_t> upOffsets;     // Edges to more important areas, by source
+    vector<int> upEdges;
+    vector<size_t> downOffsets;   // Edges from more important areas, by target
+    vector<int> downEdges;
+    size_t shortcuts = 0;
+
+    // Query scratch space, reset through the touched lists
+    vector<int> forwardDist, backwardDist;
+    vector<int> forwardEdge, backwardEdge;
+    vector<int> touched;
+
+    typedef priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> Queue;
+
+    // Areas a witness search may settle when estimating priorities / when contracting
+    static const int ESTIMATE_SETTLE_LIMIT = 10;
+    static const int WITNESS_SETTLE_LIMIT = 500;
+
+    // Contraction state: edges between areas that are not yet contracted
+    struct Builder {
+        vector<vector<int>> out, in;
+        vector<char> contracted;
+        vector<int> deletedNeighbours;
+        vector<int> level;            // Depth of the contracted areas below each area
+        vector<int> witnessDist;
+        vector<int> witnessTouched;
+        vector<char> witnessTarget;   // Areas the current witness search must reach
+        vector<pair<int, int>> witnessHeap;
+    };
+
+    // Bounded Dijkstra from 'start' that avoids 'skip', stopping once 'targets'
+    // marked in witnessTarget are settled; leaves distances in witnessDist
+    void witnessSearch(Builder& b, int start, int skip, int maxDist, int settleLimit, int targets) {
+        for (int v : b.witnessTouched) {
+            b.witnessDist[v] = INT_MAX;
+        }
+        b.witnessTouched.clear();
+        b.witnessDist[start] = 0;
+        b.witnessTouched.push_back(start);
+        vector<pair<int, int>>& heap = b.witnessHeap; // Min-heap reused across searches
+        greater<pair<int, int>> later;
+        heap.assign(1, {0, start});
+        int settled = 0;
+        while (!heap.empty() && settled < settleLimit) {
+            pop_heap(heap.begin(), heap.end(), later);
+            int d = heap.back().first, u = heap.back().second;
+            heap.pop_back();
+            if (d > b.witnessDist[u]) continue;
+            if (d > maxDist) break;
+            ++settled;
+            if (b.witnessTarget[u] && --targets == 0) break;
+            for (int e : b.out[u]) {
+                int v = edges[e].to;
+                if (v == skip) continue;
+                if (d + edges[e].weight < b.witnessDist[v]) {
+                    if (b.witnessDist[v] == INT_MAX) {
+                        b.witnessTouched.push_back(v);
+                    }
+                    b.witnessDist[v] = d + edges[e].weight;
+                    heap.push_back({b.witnessDist[v], v});
+                    push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+    }
+
+    // Shortcuts needed to contract 'v', as (in edge, out edge) pairs
+    vector<pair<int, int>> neededShortcuts(Builder& b, int v, int settleLimit) {
+        vector<pair<int, int>> needed;
+        for (int in : b.in[v]) {
+            int u = edges[in].from;
+            int maxDist = -1, targets = 0;
+            for (int out : b.out[v]) {
+                if (edges[out].to != u) {
+                    maxDist = max(maxDist, edges[in].weight + edges[out].weight);
+                    b.witnessTarget[edges[out].to] = 1;
+                    ++targets;
+                }
+            }
+            if (maxDist < 0) {
+                continue; // Only a road straight back to u
+            }
+            witnessSearch(b, u, v, maxDist, settleLimit, targets);
+            for (int out : b.out[v]) {
+                b.witnessTarget[edges[out].to] = 0;
+            }
+            for (int out : b.out[v]) {
+                int w = edges[out].to;
+                if (w != u && edges[in].weight + edges[out].weight < b.witnessDist[w]) {
+                    needed.push_back({in, out});
+                }
+            }
+        }
+        return needed;
+    }
+
+    // Contract first the areas that add few shortcuts, sit among few contracted
+    // areas and low in the hierarchy, so the hierarchy stays shallow and even
+    int priority(Builder& b, int v) {
+        int added = static_cast<int>(neededShortcuts(b, v, ESTIMATE_SETTLE_LIMIT).size());
+        int removed = static_cast<int>(b.in[v].size() + b.out[v].size());
+        return 4 * (added - removed) + 2 * b.deletedNeighbours[v] + b.level[v];
+    }
+
+    // Add an edge between uncontracted areas, keeping only the shortest of parallel edges
+    void addEdge(Builder& b, const Edge& edge) {
+        for (int& e : b.out[edge.from]) {
+            if (edges[e].to == edge.to) {
+                if (edges[e].weight <= edge.weight) {
+                    return;
+                }
+                int replaced = e;
+                e = static_cast<int>(edges.size());
+                for (int& f : b.in[edge.to]) {
+                    if (f == replaced) {
+                        f = e;
+                    }
+                }
+                edges.push_back(edge);
+                return;
+            }
+        }
+        b.out[edge.from].push_back(static_cast<int>(edges.size()));
+        b.in[edge.to].push_back(static_cast<int>(edges.size()));
+        edges.push_back(edge);
+    }
+
+    void contract(Builder& b, int v, vector<int>& up, vector<int>& down) {
+        for (const pair<int, int>& s : neededShortcuts(b, v, WITNESS_SETTLE_LIMIT)) {
+            addEdge(b, {edges[s.first].from, edges[s.second].to, edges[s.first].weight + edges[s.second].weight,
+                        s.first, s.second});
+            ++shortcuts;
+        }
+        // The remaining edges of v all lead to more important areas
+        for (int e : b.out[v]) {
+            up.push_back(e);
+            int w = edges[e].to;
+            b.in[w].erase(find(b.in[w].begin(), b.in[w].end(), e));
+            ++b.deletedNeighbours[w];
+            b.level[w] = max(b.level[w], b.level[v] + 1);
+        }
+        for (int e : b.in[v]) {
+            down.push_back(e);
+            int u = edges[e].from;
+            b.out[u].erase(find(b.out[u].begin(), b.out[u].end(), e));
+            ++b.deletedNeighbours[u];
+            b.level[u] = max(b.level[u], b.level[v] + 1);
+        }
+        b.out[v].clear();
+        b.in[v].clear();
+        b.contracted[v] = 1;
+    }
+
+    // Append the areas of 'edge' after its source, expanding shortcuts
+    void unpack(int edge, vector<int>& path) const {
+        vector<int> stack{edge};
+        while (!stack.empty()) {
+            const Edge& e = edges[stack.back()];
+            stack.pop_back();
+            if (e.first < 0) {
+                path.push_back(e.to);
+            } else {
+                stack.push_back(e.second);
+                stack.push_back(e.first);
+            }
+        }
+    }
+
+    // Run the bidirectional upward search; returns the meeting area or -1
+    int search(int start, int target, int& best) {
+        for (int v : touched) {
+            forwardDist[v] = backwardDist[v] = INT_MAX;
+            forwardEdge[v] = backwardEdge[v] = -1;
+        }
+        touched.clear();
+        best = INT_MAX;
+        int meet = -1;
+        Queue forward, backward;
+        forwardDist[start] = 0;
+        backwardDist[target] = 0;
+        touched.push_back(start);
+        touched.push_back(target);
+        forward.push({0, start});
+        backward.push({0, target});
+
+        while (!forward.empty() || !backward.empty()) {
+            bool forwardTurn = backward.empty() || (!forward.empty() && forward.top().first <= backward.top().first);
+            Queue& pq = forwardTurn ? forward : backward;
+            if (pq.top().first >= best) {
+                pq = Queue(); // This direction can no longer improve the result
+                continue;
+            }
+            vector<int>& dist = forwardTurn ? forwardDist : backwardDist;
+            const vector<int>& other = forwardTurn ? backwardDist : forwardDist;
+            vector<int>& via = forwardTurn ? forwardEdge : backwardEdge;
+            int d = pq.top().first, u = pq.top().second;
+            pq.pop();
+            if (d > dist[u]) continue;
+            if (other[u] != INT_MAX && d + other[u] < best) {
+                best = d + other[u];
+                meet = u;
+            }
+            const vector<size_t>& offsets = forwardTurn ? upOffsets : downOffsets;
+            const vector<int>& list = forwardTurn ? upEdges : downEdges;
+
+            // Stall on demand: if a more important area already reaches u more
+            // cheaply, u is not on a shortest upward path and is not expanded
+            const vector<size_t>& stallOffsets = forwardTurn ? downOffsets : upOffsets;
+            const vector<int>& stallList = forwardTurn ? downEdges : upEdges;
+            bool stalled = false;
+            for (size_t i = stallOffsets[u]; i < stallOffsets[u + 1] && !stalled; ++i) {
+                const Edge& e = edges[stallList[i]];
+                int x = forwardTurn ? e.from : e.to;
+                stalled = dist[x] != INT_MAX && dist[x] + e.weight < d;
+            }
+            if (stalled) continue;
+
+            for (size_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+                const Edge& e = edges[list[i]];
+                int v = forwardTurn ? e.to : e.from;
+                if (d + e.weight < dist[v]) {
+                    if (forwardDist[v] == INT_MAX && backwardDist[v] == INT_MAX) {
+                        touched.push_back(v);
+                    }
+                    dist[v] = d + e.weight;
+                    via[v] = list[i];
+                    pq.push({dist[v], v});
+                }
+            }
         }
+        return meet;
     }
 
-    // Method to load data from a file
-    void loadFromFile(const string& filename) {
-        ifstream inFile(filename); // Open file for reading
-        if (inFile.is_open()) {
-            string line;
-            // Reading the file line by line
-            while (getline(inFile, line)) {
-                stringstream ss(line);
-                string idStr, name, wasteQuantityStr, wasteCategory, areaSizeStr, location, populationStr,
-                        wasteManagementStrategy, environmentalImpactStr, budgetAllocatedStr, lastUpdatedStr;
-
-                // Parsing the CSV line into individual components
-                getline(ss, idStr, ',');
-                getline(ss, name, ',');
-                getline(ss, wasteQuantityStr, ',');
-                getline(ss, wasteCategory, ',');
-                getline(ss, areaSizeStr, ',');
-                getline(ss, location, ',');
-                getline(ss, populationStr, ',');
-                getline(ss, wasteManagementStrategy, ',');
-                getline(ss, environmentalImpactStr, ',');
-                getline(ss, budgetAllocatedStr, ',');
-                getline(ss, lastUpdatedStr);
-
-                // Convert strings to appropriate data types and add the area to the system
-                int id = stoi(idStr);
-                double wasteQuantity = stod(wasteQuantityStr);
-                double areaSize = stod(areaSizeStr);
-                int population = stoi(populationStr);
-                double environmentalImpact = stod(environmentalImpactStr);
-                double budgetAllocated = stod(budgetAllocatedStr);
-                time_t lastUpdated = stoi(lastUpdatedStr); // Assuming the lastUpdated time is stored as a timestamp
-
-                // Add the area using the parsed data
-                addArea(id, name, wasteQuantity, wasteCategory, areaSize, location, population, lastUpdated,
-                        wasteManagementStrategy, environmentalImpact, budgetAllocated);
-            }
-            cout << "Data loaded from " << filename << endl;
-        } else {
-            cout << "Error loading data from file.\n";
+public:
+    // Function to preprocess the open roads of 'network'
+    void build(const RoadNetwork& network) {
+        int n = network.areaCount();
+        edges.clear();
+        shortcuts = 0;
+        Builder b;
+        b.out.assign(n, {});
+        b.in.assign(n, {});
+        b.contracted.assign(n, 0);
+        b.deletedNeighbours.assign(n, 0);
+        b.level.assign(n, 0);
+        b.witnessDist.assign(n, INT_MAX);
+        b.witnessTarget.assign(n, 0);
+        for (int u = 0; u < n; ++u) {
+            for (size_t e = network.roadsBegin(u); e < network.roadsEnd(u); ++e) {
+                if (network.isOpen(e) && network.target(e) != u) {
+                    addEdge(b, {u, network.target(e), network.weight(e), -1, -1});
+                }
+            }
+        }
+
+        // Contract in order of priority, re-checking each priority lazily on pop
+        Queue order;
+        vector<int> queued(n);        // Latest priority pushed for each area
+        for (int v = 0; v < n; ++v) {
+            queued[v] = priority(b, v);
+            order.push({queued[v], v});
+        }
+        vector<vector<int>> up(n), down(n);
+        rank.assign(n, 0);
+        int next = 0;
+        while (!order.empty()) {
+            int p = order.top().first, v = order.top().second;
+            order.pop();
+            if (b.contracted[v] || p != queued[v]) continue;
+            int current = priority(b, v);
+            if (!order.empty() && current > order.top().first) {
+                queued[v] = current;
+                order.push({current, v});
+                continue;
+            }
+            rank[v] = next++;
+            vector<int> neighbours;
+            for (int e : b.out[v]) {
+                neighbours.push_back(edges[e].to);
+            }
+            for (int e : b.in[v]) {
+                neighbours.push_back(edges[e].from);
+            }
+            contract(b, v, up[v], down[v]);
+
+            // Contracting v changed its neighbours' costs
+            sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (int w : neighbours) {
+                queued[w] = priority(b, w);
+                order.push({queued[w], w});
+            }
+        }
+
+        // Flatten the upward edges into CSR arrays for the queries
+        upOffsets.assign(n + 1, 0);
+        downOffsets.assign(n + 1, 0);
+        upEdges.clear();
+        downEdges.clear();
+        for (int v = 0; v < n; ++v) {
+            upEdges.insert(upEdges.end(), up[v].begin(), up[v].end());
+            downEdges.insert(downEdges.end(), down[v].begin(), down[v].end());
+            upOffsets[v + 1] = upEdges.size();
+            downOffsets[v + 1] = downEdges.size();
         }
+        forwardDist.assign(n, INT_MAX);
+        backwardDist.assign(n, INT_MAX);
+        forwardEdge.assign(n, -1);
+        backwardEdge.assign(n, -1);
+        touched.clear();
     }
 
-    // Method to calculate the total budget across all areas
-    double calculateTotalBudget() const {
-        double totalBudget = 0;
-        // Loop through all areas and sum their allocated budgets
-        for (const auto& entry : nodes) {
-            totalBudget += entry.second.budgetAllocated;
-        }
-        return totalBudget;
+    // Shortest distance from 'start' to 'target', INT_MAX if not accessible
+    int distance(int start, int target) {
+        int best;
+        search(start, target, best);
+        return best;
     }
 
-    // Display area with highest environmental impact
-    void displayHighestEnvironmentalImpact() const {
-        double highestImpact = -1;
-        Area highestImpactArea;
-        // Loop through all areas to find the one with the highest environmental impact score
-        for (const auto& entry : nodes) {
-            double impact = entry.second.calculateEnvironmentalImpact();
-            if (impact > highestImpact) {
-                highestImpact = impact;
-                highestImpactArea = entry.second;
-            }
+    // Areas on a shortest path from 'start' to 'target', empty if not accessible;
+    // its length is stored in 'length'
+    vector<int> route(int start, int target, int& length) {
+        int meet = search(start, target, length);
+        if (meet < 0) {
+            return {};
+        }
+        vector<int> forwardPart;
+        for (int v = meet; v != start; v = edges[forwardEdge[v]].from) {
+            forwardPart.push_back(forwardEdge[v]);
+        }
+        vector<int> path{start};
+        for (auto it = forwardPart.rbegin(); it != forwardPart.rend(); ++it) {
+            unpack(*it, path);
         }
+        for (int v = meet; v != target; v = edges[backwardEdge[v]].to) {
+            unpack(backwardEdge[v], path);
+        }
+        return path;
+    }
 
-        cout << "\nArea with highest environmental impact:\n";
-        highestImpactArea.displayAreaInfo();
+    size_t shortcutCount() const {
+        return shortcuts;
     }
 };
 
-// Main function to interact with the system and manage areas
-void manageWasteAreas(Graph &g) {
-    // Adding areas to the graph for demonstration
-    g.addArea(1, "Tilakwadi", 1200.0, "Plastic", 8.5, "Bel,Kar", 15000, time(0), "Recycling", 85.0, 50000);
-    g.addArea(2, "Shivaji Nagar", 950.0, "Organic", 6.2, "Bel,Kar", 12000, time(0), "Composting", 75.0, 40000);
-    g.addArea(3, "Camp", 2000.0, "Electronic", 12.0, "Bel,Kar", 18000, time(0), "Disposal", 90.0, 75000);
-    g.addArea(4, "Raviwar Peth", 800.0, "Plastic", 5.5, "Bel,Kar", 10000, time(0), "Recycling", 70.0, 30000);
-    g.addArea(5, "Khanapur Road", 1500.0, "Organic", 10.0, "Bel,Kar", 20000, time(0), "Composting", 80.0, 60000);
-    g.addArea(6, "Maratha Colony", 600.0, "Plastic", 4.8, "Bel,Kar", 8000, time(0), "Recycling", 65.0, 25000);
-    g.addArea(7, "Shahapur", 2200.0, "Electronic", 14.0, "Bel,Kar", 25000, time(0), "Disposal", 95.0, 100000);
-    g.addArea(8, "Angol", 700.0, "Organic", 5.0, "Bel,Kar", 11000, time(0), "Composting", 72.0, 35000);
-    g.addArea(9, "Vivekanand Nagar", 1800.0, "Plastic", 9.0, "Bel,Kar", 17000, time(0), "Recycling", 88.0, 65000);
-    g.addArea(10, "Ramteerth Nagar", 2500.0, "Electronic", 15.0, "Bel,Kar", 30000, time(0), "Disposal", 92.0, 125000);
-
+// A* search with landmarks (ALT) for point-to-point queries
+//
+// Shortest distances to and from a few landmark areas, picked far apart, are
+// stored for every area. By the triangle inequality, |d(L, t) - d(L, v)| style
+// differences give a lower bound on the distance from v to the target t, which
+// steers the search towards t, so it settles far fewer areas than Dijkstra. The
+// search reads the live road weights: the bounds stay valid, and the answers
+// exact, while roads only get longer or close (traffic). Rebuild after a road
+// gets shorter or reopens
+class LandmarkRouter {
+private:
+    const RoadNetwork* network = nullptr;
+    int landmarkCount = 0;
+    vector<int> landmarks;
+    vector<int> fromLandmark;   // d(L, v) for area v at [v * landmarkCount + i], INT_MAX if none
+    vector<int> toLandmark;     // d(v, L)
+
+    // Query scratch space, reset through the touched list
+    vector<int> dist, parent, bound;
+    vector<int> touched;
+    size_t lastSettled = 0;
+
+    // Dijkstra from 'start' over the open roads, or against their direction
+    void landmarkDistances(int start, bool reverse, vector<int>& out) const {
+        out.assign(network->areaCount(), INT_MAX);
+        out[start] = 0;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        pq.push({0, start});
+        while (!pq.empty()) {
+            int d = pq.top().first, u = pq.top().second;
+            pq.pop();
+            if (d > out[u]) continue;
+            size_t begin = reverse ? network->incomingBegin(u) : network->roadsBegin(u);
+            size_t end = reverse ? network->incomingEnd(u) : network->roadsEnd(u);
+            for (size_t i = begin; i < end; ++i) {
+                size_t e = reverse ? network->incomingRoad(i) : i;
+                if (!network->isOpen(e)) continue;
+                int v = reverse ? network->source(e) : network->target(e);
+                if (d + network->weight(e) < out[v]) {
+                    out[v] = d + network->weight(e);
+                    pq.push({out[v], v});
+                }
+            }
+        }
+    }
 
-    int choice;
-    do {
-        // Display menu for user to choose operations
-        cout << "\nMenu:\n";
-        cout << "1. Display all areas\n";
-        cout << "2. Sort areas by waste quantity\n";
-        cout << "3. Display areas by waste category\n";
-        cout << "4. Update area data\n";
-        cout << "5. Delete area\n";
-        cout << "6. Save data to file\n";
-        cout << "7. Load data from file\n";
-        cout << "8. Calculate total budget\n";
-        cout << "9. Display area with highest environmental impact\n";
-        cout << "10. Exit\n";
-        cout << "Enter your choice: ";
-        cin >> choice;
+    // Lower bound on the distance from 'v' to 'target'
+    int lowerBound(int v, int target) const {
+        const int* fromV = &fromLandmark[static_cast<size_t>(v) * landmarkCount];
+        const int* toV = &toLandmark[static_cast<size_t>(v) * landmarkCount];
+        const int* fromT = &fromLandmark[static_cast<size_t>(target) * landmarkCount];
+        const int* toT = &toLandmark[static_cast<size_t>(target) * landmarkCount];
+        int best = 0;
+        for (int i = 0; i < landmarkCount; ++i) {
+            if (fromV[i] != INT_MAX && fromT[i] != INT_MAX) {
+                best = max(best, fromT[i] - fromV[i]); // d(L, t) <= d(L, v) + d(v, t)
+            }
+            if (toV[i] != INT_MAX && toT[i] != INT_MAX) {
+                best = max(best, toV[i] - toT[i]);     // d(v, L) <= d(v, t) + d(t, L)
+            }
+        }
+        return best;
+    }
 
-        // Switch case to handle the user's choice
-        switch (choice) {
-            case 1:
-                g.displayAreas(); // Display all areas
-                break;
-            case 2:
-                g.sortAreasByWaste(); // Sort areas by waste quantity
-                cout << "Areas sorted by waste quantity.\n";
-                break;
-            case 3: {
-                string category;
-                cout << "Enter waste category: ";
-                cin.ignore();
-                getline(cin, category); // Get waste category from user
-                g.displayAreasByCategory(category); // Display areas by waste category
-                break;
+public:
+    // Function to pick up to 'count' landmarks far apart and store their distances.
+    // Each new landmark is the area farthest from the ones already chosen
+    void build(const RoadNetwork& roads, int count) {
+        network = &roads;
+        int n = roads.areaCount();
+        landmarks.clear();
+        vector<vector<int>> forward, backward;
+        vector<int> nearest(n, INT_MAX); // Distance from the closest chosen landmark
+        int next = 0;
+        for (int i = 0; i < count && n > 0; ++i) {
+            vector<int> d;
+            landmarkDistances(next, false, d);
+            if (i == 0) {
+                // Start from the area farthest from area 0, on the edge of the network
+                int far = 0;
+                for (int v = 0; v < n; ++v) {
+                    if (d[v] != INT_MAX && d[v] > d[far]) {
+                        far = v;
+                    }
+                }
+                next = far;
+                landmarkDistances(next, false, d);
             }
-            case 4: {
-                int id;
-                cout << "Enter area ID to update: ";
-                cin >> id; // Get area ID to update from user
-                g.updateAreaData(id); // Update area data
-                break;
+            landmarks.push_back(next);
+            forward.push_back(move(d));
+            int far = -1;
+            for (int v = 0; v < n; ++v) {
+                nearest[v] = min(nearest[v], forward.back()[v]);
+                if (nearest[v] != INT_MAX && nearest[v] > 0 && (far < 0 || nearest[v] > nearest[far])) {
+                    far = v;
+                }
             }
-            case 5: {
-                int id;
-                cout << "Enter area ID to delete: ";
-                cin >> id; // Get area ID to delete from user
-                g.deleteArea(id); // Delete area by ID
-                break;
+            if (far < 0) {
+                break; // Every reachable area is already a landmark
             }
-            case 6: {
-                string filename;
-                cout << "Enter filename to save data: ";
-                cin >> filename; // Get filename to save data
-                g.saveToFile(filename); // Save data to file
-                break;
+            next = far;
+        }
+
+        landmarkCount = static_cast<int>(landmarks.size());
+        backward.resize(landmarkCount);
+        runParallel(landmarkCount, [&](size_t i) { landmarkDistances(landmarks[i], true, backward[i]); });
+
+        fromLandmark.assign(static_cast<size_t>(n) * landmarkCount, INT_MAX);
+        toLandmark.assign(static_cast<size_t>(n) * landmarkCount, INT_MAX);
+        for (int i = 0; i < landmarkCount; ++i) {
+            for (int v = 0; v < n; ++v) {
+                fromLandmark[static_cast<size_t>(v) * landmarkCount + i] = forward[i][v];
+                toLandmark[static_cast<size_t>(v) * landmarkCount + i] = backward[i][v];
             }
-            case 7: {
-                string filename;
-                cout << "Enter filename to load data: ";
-                cin >> filename; // Get filename to load data
-                g.loadFromFile(filename); // Load data from file
+        }
+        dist.assign(n, INT_MAX);
+        parent.assign(n, -1);
+        bound.assign(n, -1);
+        touched.clear();
+    }
+
+    // Areas on a shortest path from 'start' to 'target', empty if not accessible;
+    // its length is stored in 'length'
+    vector<int> route(int start, int target, int& length) {
+        for (int v : touched) {
+            dist[v] = INT_MAX;
+            parent[v] = -1;
+            bound[v] = -1;
+        }
+        touched.clear();
+        lastSettled = 0;
+
+        // Queue keys are distance plus lower bound on the rest of the way
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        dist[start] = 0;
+        bound[start] = lowerBound(start, target);
+        touched.push_back(start);
+        pq.push({bound[start], start});
+        while (!pq.empty()) {
+            int key = pq.top().first, u = pq.top().second;
+            pq.pop();
+            if (key > dist[u] + bound[u]) continue;
+            ++lastSettled;
+            if (u == target) {
                 break;
             }
-            case 8: {
-                double totalBudget = g.calculateTotalBudget(); // Calculate the total budget
-                cout << "Total budget allocated across all areas: " << totalBudget << endl;
-                break;
+            for (size_t e = network->roadsBegin(u), end = network->roadsEnd(u); e < end; ++e) {
+                if (!network->isOpen(e)) continue;
+                int v = network->target(e);
+                int d = dist[u] + network->weight(e);
+                if (d < dist[v]) {
+                    if (bound[v] < 0) {
+                        bound[v] = lowerBound(v, target);
+                        touched.push_back(v);
+                    }
+                    dist[v] = d;
+                    parent[v] = u;
+                    pq.push({d + bound[v], v});
+                }
             }
-            case 9:
-                g.displayHighestEnvironmentalImpact(); // Display area with highest environmental impact
-                break;
-            case 10:
-                cout << "Exiting program...\n"; // Exit the program
-                break;
-            default:
-                cout << "Invalid option! Try again.\n"; // Handle invalid option
-                break;
         }
 
-    } while (choice != 10); // Continue until user chooses to exit
-}
-
-
-//module2
-
-#include <iostream>
-#include <vector>
-#include <climits>
-#include <queue>
+        length = dist[target];
+        if (length == INT_MAX) {
+            return {};
+        }
+        vector<int> path;
+        for (int v = target; v != -1; v = parent[v]) {
+            path.push_back(v);
+        }
+        reverse(path.begin(), path.end());
+        return path;
+    }
 
-using namespace std;
+    const vector<int>& landmarkAreas() const {
+        return landmarks;
+    }
 
-// Define a structure to store area information
-struct Areas {
-    string name;
-    vector<pair<int, int>> roads;  // {destination, distance}
+    // Areas settled by the last route() call
+    size_t settledAreas() const {
+        return lastSettled;
+    }
 };
 
-// Number of areas
-const int N = 10;
-Areas areas[N];
-
-// Truck capacity (in units of waste)
-const int TRUCK_CAPACITY = 100;
-
-// Function to find shortest paths using Dijkstra's Algorithm
-void dijkstra(int start, vector<int>& dist) {
-    dist.assign(N, INT_MAX);
-    dist[start] = 0;
-    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-    pq.push({0, start});
-
-    while (!pq.empty()) {
-        int u = pq.top().second;
-        int d = pq.top().first;
-        pq.pop();
-
-        if (d > dist[u]) continue;
-
-        for (auto& road : areas[u].roads) {
-            int v = road.first;
-            int weight = road.second;
+// All-pairs distances of the simulated city while it is small enough to keep them
+const int MAX_MATRIX_AREAS = 2048;
+DistanceMatrix areaMatrix;
 
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                pq.push({dist[v], v});
-            }
+// Function to rebuild the matrix after the road network was replaced
+void rebuildAreaMatrix() {
+    vector<int> sources;
+    if (roadNetwork.areaCount() <= MAX_MATRIX_AREAS) {
+        for (int area = 0; area < roadNetwork.areaCount(); ++area) {
+            sources.push_back(area);
         }
     }
+    areaMatrix.build(roadNetwork, sources);
+}
+
+// Function to get shortest distances from 'start': a matrix row when 'start' is
+// one of its sources, otherwise a cached shortest-path tree
+const int* distancesFrom(int start) {
+    if (areaMatrix.hasSource(start)) {
+        return areaMatrix.row(start);
+    }
+    return routeCache.distances(start).data();
 }
 
 // Function to collect waste and send trucks based on capacity
 void collectWaste(int start, vector<int>& waste) {
-    vector<int> dist(N, INT_MAX);
-    dijkstra(start, dist);
+    int n = roadNetwork.areaCount();
+    const int* dist = distancesFrom(start);
     int totalWasteCollected = 0;
     int truckCount = 0;
 
-    cout << "Waste collection starting from " << areas[start].name << ":\n";
-    for (int i = 0; i < N; ++i) {
+    cout << "Waste collection starting from " << roadNetwork.name(start) << ":\n";
+    for (int i = 0; i < n; ++i) {
         if (dist[i] == INT_MAX) {
-            cout << areas[i].name << ": Not accessible\n";
+            cout << roadNetwork.name(i) << ": Not accessible\n";
         } else {
-            totalWasteCollected += waste[i];
+            int amount = i < static_cast<int>(waste.size()) ? waste[i] : 0;
+            totalWasteCollected += amount;
             while (totalWasteCollected > (truckCount + 1) * TRUCK_CAPACITY) {
                 truckCount++;
-                cout << "Truck " << truckCount << " dispatched for area " << areas[i].name << " to collect waste.\n";
+                cout << "Truck " << truckCount << " dispatched for area " << roadNetwork.name(i) << " to collect waste.\n";
             }
-            cout << areas[i].name << ": " << waste[i] << " units collected\n";
+            cout << roadNetwork.name(i) << ": " << amount << " units collected\n";
         }
     }
 }
 
+// Function to describe the valid area numbers, e.g. "(0-9)"
+string areaRange() {
+    return "(0-" + to_string(roadNetwork.areaCount() - 1) + ")";
+}
+
+// Function to read an area number in the range of the current road network
+bool readArea(const string& prompt, int& area) {
+    cout << prompt;
+    cin >> area;
+    if (area < 0 || area >= roadNetwork.areaCount()) {
+        cout << "Invalid area number.\n";
+        return false;
+    }
+    return true;
+}
+
 // Main function
 int simulateWasteManagement() {
     // Example area names
-    areas[0].name = "Tilakwadi";
-    areas[1].name = "Shivaji Nagar";
-    areas[2].name = "Camp";
-    areas[3].name = "Raviwar Peth";
-    areas[4].name = "Khanapur Road";
-    areas[5].name = "Maratha Colony";
-    areas[6].name = "Shahapur";
-    areas[7].name = "Angol";
-    areas[8].name = "Vivekanand Nagar";
-    areas[9].name = "Ramteerth Nagar";
+    vector<string> names = {"Tilakwadi", "Shivaji Nagar", "Camp", "Raviwar Peth", "Khanapur Road",
+                            "Maratha Colony", "Shahapur", "Angol", "Vivekanand Nagar", "Ramteerth Nagar"};
 
     // Example roads (area1, area2, distance)
-    areas[0].roads = {{1, 10}, {2, 15}, {3, 35}, {4, 45}, {5, 85}, {6, 130}, {7, 180}, {8, 235}, {9, 295}};
-    areas[1].roads = {{0, 10}, {2, 5}, {3, 25}, {4, 55}, {5, 95}, {6, 125}, {7, 180}, {8, 230}, {9, 280}};
+    vector<Road> roads = {
+        {0, 1, 10}, {0, 2, 15}, {0, 3, 35}, {0, 4, 45}, {0, 5, 85}, {0, 6, 130}, {0, 7, 180}, {0, 8, 235}, {0, 9, 295},
+        {1, 0, 10}, {1, 2, 5}, {1, 3, 25}, {1, 4, 55}, {1, 5, 95}, {1, 6, 125}, {1, 7, 180}, {1, 8, 230}, {1, 9, 280}};
     // More roads defined similarly...
+    roadNetwork.build(names, roads);
+    routeCache.clear();
+    rebuildAreaMatrix();
 
     // Example waste to be collected from each area
     vector<int> waste = {50, 75, 20, 30, 60, 40, 80, 70, 90, 100}; // waste in units
@@ -579,22 +7437,25 @@ int simulateWasteManagement() {
         cout << "2. Close Road\n";
         cout << "3. Waste Collection using Trucks\n";
         cout << "4. Exit\n";
+        cout << "5. Load Road Network from File\n";
+        cout << "6. Reopen Road\n";
+        cout << "7. Change Road Distance\n";
         cout << "Enter your choice: ";
         cin >> choice;
 
         switch (choice) {
             case 1: {
                 int start;
-                cout << "Enter the start area (0-9): ";
-                cin >> start;
-                vector<int> dist;
-                dijkstra(start, dist);
-                cout << "Shortest paths from area " << areas[start].name << ":\n";
-                for (int i = 0; i < N; ++i) {
+                if (!readArea("Enter the start area " + areaRange() + ": ", start)) {
+                    break;
+                }
+                const int* dist = distancesFrom(start);
+                cout << "Shortest paths from area " << roadNetwork.name(start) << ":\n";
+                for (int i = 0; i < roadNetwork.areaCount(); ++i) {
                     if (dist[i] == INT_MAX) {
-                        cout << areas[i].name << ": Not accessible\n";
+                        cout << roadNetwork.name(i) << ": Not accessible\n";
                     } else {
-                        cout << areas[i].name << ": " << dist[i] << " units\n";
+                        cout << roadNetwork.name(i) << ": " << dist[i] << " units\n";
                     }
                 }
                 break;
@@ -602,17 +7463,31 @@ int simulateWasteManagement() {
 
             case 2: {
                 int u, v;
-                cout << "Enter the two areas (0-9) to close the road between (u, v): ";
+                cout << "Enter the two areas " << areaRange() << " to close the road between (u, v): ";
                 cin >> u >> v;
-                // Code to close the road between u and v (remove edges) can be added here
-                cout << "Road closed between " << areas[u].name << " and " << areas[v].name << ".\n";
+                if (u < 0 || u >= roadNetwork.areaCount() || v < 0 || v >= roadNetwork.areaCount()) {
+                    cout << "Invalid area number.\n";
+                    break;
+                }
+                vector<size_t> closedRoads = roadNetwork.closeRoad(u, v);
+                if (closedRoads.empty()) {
+                    cout << "No open road between " << roadNetwork.name(u) << " and " << roadNetwork.name(v) << ".\n";
+                    break;
+                }
+                size_t before = routeCache.recomputedAreas();
+                routeCache.roadsClosed(closedRoads); // Repair only the paths that used the road
+                areaMatrix.roadsClosed(closedRoads);
+                cout << "Road closed between " << roadNetwork.name(u) << " and " << roadNetwork.name(v) << ".\n";
+                cout << routeCache.cachedTrees() << " cached route trees updated, "
+                     << routeCache.recomputedAreas() - before << " area distances recomputed.\n";
                 break;
             }
 
             case 3: {
                 int start;
-                cout << "Enter the start area (0-9) for waste collection: ";
-                cin >> start;
+                if (!readArea("Enter the start area " + areaRange() + " for waste collection: ", start)) {
+                    break;
+                }
                 collectWaste(start, waste);
                 break;
             }
@@ -621,6 +7496,67 @@ int simulateWasteManagement() {
                 cout << "Exiting program.\n";
                 break;
 
+            case 5: {
+                string filename, error;
+                cout << "Enter road network filename: ";
+                cin >> filename;
+                RoadNetwork loaded;
+                if (!loaded.loadFromFile(filename, error)) {
+                    cout << "Error loading " << filename << ": " << error << "\n";
+                    break;
+                }
+                roadNetwork = move(loaded);
+                routeCache.clear();
+                rebuildAreaMatrix();
+                waste.resize(roadNetwork.areaCount(), 0); // New areas start with no waste
+                cout << "Loaded " << roadNetwork.areaCount() << " areas and " << roadNetwork.roadCount()
+                     << " roads from " << filename << "\n";
+                break;
+            }
+
+            case 6: {
+                int u, v;
+                cout << "Enter the two areas " << areaRange() << " to reopen the road between (u, v): ";
+                cin >> u >> v;
+                if (u < 0 || u >= roadNetwork.areaCount() || v < 0 || v >= roadNetwork.areaCount()) {
+                    cout << "Invalid area number.\n";
+                    break;
+                }
+                vector<size_t> reopened = roadNetwork.reopenRoad(u, v);
+                if (reopened.empty()) {
+                    cout << "No closed road between " << roadNetwork.name(u) << " and " << roadNetwork.name(v) << ".\n";
+                    break;
+                }
+                routeCache.roadsOpened(reopened);
+                areaMatrix.roadsOpened(reopened);
+                cout << "Road reopened between " << roadNetwork.name(u) << " and " << roadNetwork.name(v) << ".\n";
+                break;
+            }
+
+            case 7: {
+                int u, v, distance;
+                cout << "Enter the two areas " << areaRange() << " and the new distance (u, v, distance): ";
+                cin >> u >> v >> distance;
+                if (u < 0 || u >= roadNetwork.areaCount() || v < 0 || v >= roadNetwork.areaCount() || distance < 0 ||
+                    distance > RoadNetwork::maxRoadDistance(roadNetwork.areaCount())) {
+                    cout << "Invalid area number or distance.\n";
+                    break;
+                }
+                size_t road = roadNetwork.findRoad(u, v);
+                if (road == SIZE_MAX) {
+                    cout << "No road from " << roadNetwork.name(u) << " to " << roadNetwork.name(v) << ".\n";
+                    break;
+                }
+                int oldWeight = roadNetwork.weight(road);
+                roadNetwork.setWeight(road, distance);
+                routeCache.roadWeightChanged(road, oldWeight);
+                areaMatrix.roadWeightChanged(road, oldWeight); // Affected rows refresh on their next use
+                cout << "Road from " << roadNetwork.name(u) << " to " << roadNetwork.name(v) << " changed from "
+                     << oldWeight << " to " << distance << " units; " << areaMatrix.staleRows()
+                     << " distance rows to refresh.\n";
+                break;
+            }
+
             default:
                 cout << "Invalid choice. Please try again.\n";
         }
@@ -730,16 +7666,12 @@ std::string classifyWaste(const std::string& waste)
 void displayWasteItems(const std::vector<std::string>& wasteItems)
 {
     std::cout << "\nWaste Items in the System:\n";
-    std::cout << std::setw(40) << std::left << "Waste Item"
-              << std::setw(20) << std::left << "Classification"
-              << "\n";
-    std::cout << std::string(60, '-') << "\n";
+    ReportTable table({"Waste Item", "Classification"});
     for (const auto& item : wasteItems)
     {
-        std::cout << std::setw(40) << std::left << item
-                  << std::setw(20) << std::left << classifyWaste(item)
-                  << "\n";
+        table.cell(item).cell(classifyWaste(item));
     }
+    table.render(std::cout);
 }
 
 
@@ -2685,13 +9617,17 @@ public:
         return true;
     }
 
-    // Display product details in a formatted table
-    void displayProduct() const
+    // Empty product table with the report columns
+    static ReportTable reportTable()
+    {
+        return ReportTable({"Product Name", "Category", "Price", "Quantity"},
+                           {ReportTable::LEFT, ReportTable::LEFT, ReportTable::RIGHT, ReportTable::RIGHT});
+    }
+
+    // Add the product details as a row of a product table
+    void addToReport(ReportTable& table) const
     {
-        cout << setw(20) << left << name
-             << setw(15) << category
-             << setw(10) << right << price
-             << setw(10) << right << quantity << endl;
+        table.cell(name).cell(category).cell(price).cell(quantity);
     }
 };
 
@@ -2790,17 +9726,12 @@ public:
             return;
         }
 
-        cout << setw(20) << left << "Product Name"
-             << setw(15) << "Category"
-             << setw(10) << "Price"
-             << setw(10) << "Quantity" << endl;
-        cout << string(55, '-')
-        << endl;
-
+        ReportTable table = Product::reportTable();
         for (const auto& product : products)
         {
-            product.displayProduct();
+            product.addToReport(table);
         }
+        table.render(cout);
     }
 
     // Sell a product by name and quantity
@@ -2834,21 +9765,22 @@ public:
     // Advanced product search
     void searchProduct(const string& keyword) const
     {
-        bool found = false;
-        cout << "Searching for products with keyword: " << keyword << endl;
+        cout << "Searching for products with keyword: " << keyword << "\n";
+        ReportTable table = Product::reportTable();
         for (const auto& product : products)
         {
             if (product.getName().find(keyword) != string::npos ||
                 product.getCategory().find(keyword) != string::npos)
             {
-                product.displayProduct();
-                found = true;
+                product.addToReport(table);
             }
         }
-        if (!found)
+        if (table.rowCount() == 0)
         {
             cout << "No products matched your search." << endl;
+            return;
         }
+        table.render(cout);
     }
 
     // Display inventory report with statistics
@@ -2861,16 +9793,12 @@ public:
             return;
         }
 
-        cout << setw(20) << left << "Product Name"
-             << setw(15) << "Category"
-             << setw(10) << "Price"
-             << setw(10) << "Quantity" << endl;
-        cout << string(55, '-') << endl;
-
+        ReportTable table = Product::reportTable();
         for (const auto& product : products)
         {
-            product.displayProduct();
+            product.addToReport(table);
         }
+        table.render(cout);
 
         // Display statistics at the end of the report
         displayStatistics();
@@ -3045,7 +9973,22 @@ int manageWasteSystem() {
 #include <iostream>
 using namespace std;
 
-int main() {
+// Run the built-in self-checks; returns true if every check passed
+bool runSelfTests() {
+    bool ok = true;
+    ok = runConcurrentRegistryCheck(20000, 4, 3.0) && ok; // Writer and readers on a scratch registry
+    ok = runDurableHistoryCheck() && ok;
+    ok = runDistanceMatrixCheck() && ok;
+    cout << (ok ? "All self-checks passed" : "Self-checks FAILED") << endl;
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    // "--self-test" runs the self-checks instead of the menus; the exit status reports the result
+    if (argc > 1 && string(argv[1]) == "--self-test") {
+        return runSelfTests() ? 0 : 1;
+    }
+
     int choice;
     Graph g;  // Declare the variable outside the switch
 
@@ -4258,6 +11201,15 @@ private:
     std::vector<std::string> areas;
     // Map to store allocations by date
     std::map<std::string, std::vector<AllocationDetail>> allocations;
+    // The route graph in CSR form, the distances between all its areas (small
+    // networks only) and a contraction hierarchy for point-to-point queries
+    RoadNetwork network;
+    DistanceMatrix travelMatrix;
+    ContractionHierarchy hierarchy;
+    // Landmark distances for A* route queries, used while altMode is on
+    static const int ALT_LANDMARKS = 8;
+    LandmarkRouter landmarkRouter;
+    bool altMode = false;
 
 
 
@@ -4362,6 +11314,74 @@ public:
 
         };
 
+        buildRoutingEngines();
+    }
+
+    // Function to rebuild the road network, distance matrix and contraction
+    // hierarchy from the route graph
+    void buildRoutingEngines()
+    {
+        std::vector<Road> roads;
+        std::vector<int> sources;
+        for (int u = 0; u < static_cast<int>(graph.size()); u++)
+        {
+            for (const auto& [v, weight] : graph[u])
+            {
+                roads.push_back({u, v, weight});
+            }
+            if (graph.size() <= static_cast<size_t>(MAX_MATRIX_AREAS))
+            {
+                sources.push_back(u);
+            }
+        }
+        network.build(areas, roads);
+        travelMatrix.build(network, sources);
+        hierarchy.build(network);
+        landmarkRouter.build(network, ALT_LANDMARKS);
+    }
+
+    // Function to switch shortest route details between Dijkstra and A* with landmarks
+    void toggleAltMode()
+    {
+        altMode = !altMode;
+        std::cout << "Shortest routes now use " << (altMode ? "A* with landmarks (ALT)" : "Dijkstra's algorithm")
+                  << "." << std::endl;
+    }
+
+    // Function to replace the route graph with a road network file (same format
+    // as the route module: counts, area names, then "from to distance" roads)
+    bool loadRoadNetwork(const std::string& filename)
+    {
+        RoadNetwork loaded;
+        std::string error;
+        if (!loaded.loadFromFile(filename, error))
+        {
+            std::cout << "Error loading " << filename << ": " << error << std::endl;
+            return false;
+        }
+        if (loaded.areaCount() == 0)
+        {
+            std::cout << "Error loading " << filename << ": the road network has no areas" << std::endl;
+            return false;
+        }
+        areas.clear();
+        graph.assign(loaded.areaCount(), {});
+        for (int u = 0; u < loaded.areaCount(); u++)
+        {
+            areas.push_back(loaded.name(u));
+            for (size_t e = loaded.roadsBegin(u); e < loaded.roadsEnd(u); e++)
+            {
+                graph[u].push_back({loaded.target(e), loaded.weight(e)});
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        buildRoutingEngines();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Loaded " << network.areaCount() << " areas and " << network.roadCount() << " roads; "
+                  << "contraction hierarchy built in " << seconds << " s with " << hierarchy.shortcutCount()
+                  << " shortcuts." << std::endl;
+        return true;
     }
 
     // Function to get the index of an area
@@ -4379,6 +11399,44 @@ public:
         return -1;
     }
 
+    // Function to get the number of areas in the route graph
+    int areaCount() const
+    {
+        return static_cast<int>(areas.size());
+    }
+
+    // Function to get the number of waste collection entries
+    int wasteCount() const
+    {
+        return static_cast<int>(wastes.size());
+    }
+
+    // Function to get the area routes start from: Kanabargi, or the first
+    // area of a loaded road network that does not have it
+    int depotIndex()
+    {
+        int depot = getAreaIndex("Kanabargi");
+        return depot == -1 ? 0 : depot;
+    }
+
+    // Function to list the route graph areas with the index to enter for each
+    void displayAreaIndices() const
+    {
+        for (int i = 0; i < areaCount(); i++)
+        {
+            std::cout << i + 1 << ": " << areas[i] << "\n";
+        }
+    }
+
+    // Function to list the waste collection entries with the index to enter for each
+    void displayWasteIndices() const
+    {
+        for (int i = 0; i < wasteCount(); i++)
+        {
+            std::cout << i + 1 << ": " << wastes[i].area << "\n";
+        }
+    }
+
 
     // Add Vehicle
     void addVehicle(Vehicle v)
@@ -4578,40 +11636,37 @@ void dfsLongestPath(int u, std::vector<bool>& visited, std::vector<int>& dist, s
                     std::cout << "  Driver name : " << drivers[0].name << " from " << drivers[0].address
                               << " for waste in " << wastes[wasteIndex].area << " on " << date << std::endl;
                     std::cout << " Driver address :" << drivers[0].address << std::endl;
-                    std::cout << "Route details from Kanabargi to " << wastes[wasteIndex].area << ":\n";
-                    int source = 0;  // Kanabargi
+                    int source = depotIndex();
                     int destination = getAreaIndex(wastes[wasteIndex].area);
 
                     if (destination != -1)
 
                       {
-                        std::vector<int> parent;
-                        std::vector<int> distance = dijkstra(source, destination, parent);
-                        if (distance[destination] == std::numeric_limits<int>::max())
+                        std::cout << "Route details from " << areas[source] << " to " << wastes[wasteIndex].area << ":\n";
+                        // Small networks read the precomputed matrix (the route is traced
+                        // back through its row); large ones query the contraction hierarchy
+                        bool useMatrix = travelMatrix.hasSource(source);
+                        int length = 0;
+                        std::vector<int> path = useMatrix ? travelMatrix.route(source, destination)
+                                                          : hierarchy.route(source, destination, length);
+                        if (path.empty())
 
                         {
                             std::cout << "No route found to the destination." << std::endl;
                             return;
                         }
 
-                        std::stack<int> path;
                         std::vector<std::string> route;
-                        for (int at = destination; at != -1; at = parent[at])
-
-                          {
-                            path.push(at);
-                        }
-                        while (!path.empty())
+                        for (size_t k = 0; k < path.size(); k++)
 
                         {
-                            std::cout << areas[path.top()] << (path.size() > 1 ? " -> " : "");
-                            route.push_back(areas[path.top()]);
-                            path.pop();
+                            std::cout << areas[path[k]] << (k + 1 < path.size() ? " -> " : "");
+                            route.push_back(areas[path[k]]);
 
                         }
                         std::cout << std::endl;
 
-                        double totalDistance = distance[destination];
+                        double totalDistance = useMatrix ? travelMatrix.distance(source, destination) : length;
                         double travelTime = calculateTravelTime(totalDistance);
                         int hours = static_cast<int>(travelTime);
                         int minutes = static_cast<int>((travelTime - hours) * 60);
@@ -4660,31 +11715,25 @@ void displayCollectedWasteByDate() {
     std::cout << "             Waste Collection Details by Date            \n";
     std::cout << "=========================================================\n";
 
-    // Iterate through each allocation date and its details
+    // One table row per allocation, grouped by date
+    ReportTable table({"Date", "Vehicle Model", "Driver Name", "Waste Area", "Fuel (liters)", "Route"},
+                      {ReportTable::LEFT, ReportTable::LEFT, ReportTable::LEFT, ReportTable::LEFT,
+                       ReportTable::RIGHT, ReportTable::LEFT});
     for (const auto& [date, details] : allocations) {
-        std::cout << "\nDate: " << date << "\n";
-        std::cout << "---------------------------------------------------------\n";
-
-        // Display all details for a specific date
         for (const auto& detail : details) {
-            std::cout << "  Vehicle Model    : " << detail.vehicleModel << "\n";
-            std::cout << "  Driver Name      : " << detail.driverName << "\n";
-            std::cout << "  Waste Area       : " << detail.wasteArea << "\n";
-            std::cout << "  Fuel Required    : " << detail.fuelRequired << " liters\n";
-            std::cout << "  Route            : ";
-
-            // Print the route with arrows between areas
+            // Join the route with arrows between areas
+            std::string route;
             for (size_t i = 0; i < detail.route.size(); ++i) {
-                std::cout << detail.route[i];
+                route += detail.route[i];
                 if (i != detail.route.size() - 1) {
-                    std::cout << " -> ";
+                    route += " -> ";
                 }
             }
-            std::cout << "\n---------------------------------------------------------\n";
+            table.cell(date).cell(detail.vehicleModel).cell(detail.driverName).cell(detail.wasteArea)
+                 .cell(detail.fuelRequired).cell(route);
         }
-
-        std::cout << "\n=========================================================\n";
     }
+    table.render(std::cout);
 
     // Summary or concluding message (optional)
     std::cout << "End of waste collection records.\n";
@@ -4856,6 +11905,8 @@ void loadDataFromFile(const std::string& filename)
         std::cout << "9. Save Collected Waste Data to File" << std::endl;
         std::cout << "10. Load Data from File" << std::endl;
         std::cout << "11. Exit" << std::endl;
+        std::cout << "12. Load Road Network from File" << std::endl;
+        std::cout << "13. Toggle ALT Route Mode" << std::endl;
         std::cout << " ---------------------------------------------------------------------------------------------------------" << std::endl;
 
 
@@ -5120,13 +12171,34 @@ void findLongestRouteToDestination(int source, int destination)
 // use of dijkastra algorithm
 void findShortestRouteToDestination(int source, int destination)
 {
-    std::vector<int> parent;
+    std::vector<int> path;
+    int length = std::numeric_limits<int>::max();
 
-    // Compute the shortest distances and parent paths using Dijkstra's algorithm
-    auto distances = dijkstra(source, destination, parent);
+    if (altMode)
+      {
+        // A* steered by the landmark lower bounds settles only areas towards the destination
+        path = landmarkRouter.route(source, destination, length);
+    }
+    else
+      {
+        std::vector<int> parent;
+
+        // Compute the shortest distances and parent paths using Dijkstra's algorithm
+        auto distances = dijkstra(source, destination, parent);
+        if (distances.empty())
+          {
+            return; // dijkstra() already reported that no path exists
+        }
+        length = distances[destination];
+        for (int at = destination; at != -1; at = parent[at])
+          {
+            path.push_back(at);
+        }
+        std::reverse(path.begin(), path.end());
+    }
 
     // Check if the destination is reachable from the source
-    if (distances[destination] == std::numeric_limits<int>::max())
+    if (length == std::numeric_limits<int>::max())
       {
 
         std::cout << "No path exists from " << areas[source] << " to " << areas[destination] << "." << std::endl;
@@ -5134,24 +12206,16 @@ void findShortestRouteToDestination(int source, int destination)
     }
 
     // Display the shortest distance to the destination
-    std::cout << "Shortest distance to " << areas[destination] << ": " << distances[destination] << " km" << std::endl;
+    std::cout << "Shortest distance to " << areas[destination] << ": " << length << " km" << std::endl;
 
     // Display the shortest route from source to destination
     std::cout << "Route: ";
 
-    std::stack<int> path;
-
-    for (int at = destination; at != -1; at = parent[at])
-      {
-        path.push(at);
-    }
-
     // Output the path from source to destination in human-readable format
-    while (!path.empty())
+    for (size_t k = 0; k < path.size(); k++)
     {
 
-        std::cout << areas[path.top()] << (path.size() > 1 ? " -> " : "");
-        path.pop();
+        std::cout << areas[path[k]] << (k + 1 < path.size() ? " -> " : "");
     }
 
     std::cout << std::endl;
@@ -5159,7 +12223,7 @@ void findShortestRouteToDestination(int source, int destination)
     // Calculate and display additional travel information
     //in hr and min
 
-    double totalDistance = distances[destination];
+    double totalDistance = length;
 
     double travelTime = calculateTravelTime(totalDistance);
 
@@ -5354,36 +12418,12 @@ int route()
 
             int wasteIndex;
              std::cout << "Enter destination area index:\n";
-              std::cout << "1: Kanabargi\n";
-              std::cout << "2: Belgaum\n";
-              std::cout << "3: Shivaji Nagar\n";
-              std::cout << "4: Tilakwadi\n";
-              std::cout << "5: Chennamma Nagar\n";
-              std::cout << "6: Gandhinagar\n";
-              std::cout << "7: APMC Yard\n";
-              std::cout << "8: City Market\n";
-              std::cout << "9: Fort Road\n";
-              std::cout << "10: Engg College Road\n";
-              std::cout << "11: Khanapur Road\n";
-              std::cout << "12: Udyambag\n";
-              std::cout << "13: Bogarves\n";
-              std::cout << "14: Goaves\n";
-              std::cout << "15: Hindwadi\n";
-              std::cout << "16: Mache\n";
-              std::cout << "17: Malmaruti\n";
-              std::cout << "18: Nemgoa\n";
-              std::cout << "19: Shahpur\n";
-              std::cout << "20: Sambhaji Nagar\n";
-              std::cout << "21: Angol\n";
-              std::cout << "22: Balekundri\n";
-              std::cout << "23: Camp\n";
-              std::cout << "24: Dharamnath\n";
-              std::cout << "25: Fort Lake\n";
+            bwm.displayWasteIndices();
             std::cin >> wasteIndex;
-            if(wasteIndex < 1 || wasteIndex > 25)
+            if(wasteIndex < 1 || wasteIndex > bwm.wasteCount())
               {
 
-                std::cout << "Invalid waste index. Please enter a number between 1 and 25.\n";
+                std::cout << "Invalid waste index. Please enter a number between 1 and " << bwm.wasteCount() << ".\n";
             }
             else
               {
@@ -5414,20 +12454,20 @@ int route()
            {
 
             int destination;
-            std::cout << "Enter destination area index (1: Kanabargi, 2: Belgaum, 3: Shivaji Nagar, ... 25: Fort Lake): ";
+            std::cout << "Enter destination area index (1 to " << bwm.areaCount() << ", option 6 lists them): ";
 
             std::cin >> destination;
 
-            if(destination < 1 || destination > 25)
+            if(destination < 1 || destination > bwm.areaCount())
               {
 
-                std::cout << "Invalid destination. Please enter a number between 1 and 25.\n";
+                std::cout << "Invalid destination. Please enter a number between 1 and " << bwm.areaCount() << ".\n";
 
             }
              else
               {
 
-                int source = 0; // Kanabargi
+                int source = bwm.depotIndex();
                 bwm.findShortestRouteToDestination(source, destination - 1);
             }
             break;
@@ -5439,41 +12479,16 @@ int route()
 
             int destination;
            std::cout << "Enter destination area index:\n";
-              std::cout << "1: Kanabargi\n";
-              std::cout << "2: Belgaum\n";
-              std::cout << "3: Shivaji Nagar\n";
-              std::cout << "4: Tilakwadi\n";
-              std::cout << "5: Chennamma Nagar\n";
-              std::cout << "6: Gandhinagar\n";
-              std::cout << "7: APMC Yard\n";
-              std::cout << "8: City Market\n";
-              std::cout << "9: Fort Road\n";
-              std::cout << "10: Engg College Road\n";
-              std::cout << "11: Khanapur Road\n";
-              std::cout << "12: Udyambag\n";
-              std::cout << "13: Bogarves\n";
-              std::cout << "14: Goaves\n";
-              std::cout << "15: Hindwadi\n";
-              std::cout << "16: Mache\n";
-              std::cout << "17: Malmaruti\n";
-              std::cout << "18: Nemgoa\n";
-              std::cout << "19: Shahpur\n";
-              std::cout << "20: Sambhaji Nagar\n";
-              std::cout << "21: Angol\n";
-              std::cout << "22: Balekundri\n";
-              std::cout << "23: Camp\n";
-              std::cout << "24: Dharamnath\n";
-              std::cout << "25: Fort Lake\n";
+            bwm.displayAreaIndices();
             std::cin >> destination;
-            if(destination < 1 || destination > 25)
+            if(destination < 1 || destination > bwm.areaCount())
               {
 
-                std::cout << "Invalid destination. Please enter a number between 1 and 25.\n";
+                std::cout << "Invalid destination. Please enter a number between 1 and " << bwm.areaCount() << ".\n";
             }
             else
               {
-                int source = 0;
-                // Kanabargi
+                int source = bwm.depotIndex();
 
                 bwm.findLongestRouteToDestination(source, destination - 1);
             }
@@ -5516,6 +12531,23 @@ int route()
             std::cout << "Exiting the program." << std::endl;
             break;
 
+
+
+        case 12:
+          {
+            std::string filename;
+            std::cout << "Enter road network filename: ";
+            std::cin >> filename;
+            bwm.loadRoadNetwork(filename);
+            break;
+        }
+
+
+
+        case 13:
+            bwm.toggleAltMode();
+            break;
+
         default:
 
             std::cout << "Invalid choice. Please try again." << std::endl;